@@ -15,6 +15,9 @@
 #ifndef RMW_ICEORYX_CPP__ICEORYX_DESERIALIZE_HPP_
 #define RMW_ICEORYX_CPP__ICEORYX_DESERIALIZE_HPP_
 
+#include <cstddef>
+#include <vector>
+
 struct rosidl_message_type_support_t;
 
 namespace rmw_iceoryx_cpp
@@ -26,5 +29,45 @@ void deserialize(
   const rosidl_message_type_support_t * type_supports,
   void * ros_message);
 
+/// A bounded string or sequence of a message which reserve_message presizes
+struct ReserveStep
+{
+  /// offset of the field in the message, nested messages which are no sequences are flattened
+  size_t offset;
+  /// introspection member of the C or C++ type support of the message
+  const void * member;
+  /// steps of each element of a sequence of messages, [elements_begin, elements_end) of the plan
+  size_t elements_begin;
+  size_t elements_end;
+};
+
+/// The fields of a message type which reserve_message presizes, collected once per type
+struct ReservePlan
+{
+  bool is_cpp{false};
+  std::vector<ReserveStep> steps;
+  /// steps of the message itself, the steps of sequence elements come before them
+  size_t message_begin{0u};
+  size_t message_end{0u};
+};
+
+/// @brief Collects the bounded strings and sequences of a message type and their offsets
+/// @throws std::bad_alloc if the plan can't be allocated
+ReservePlan get_reserve_plan(const rosidl_message_type_support_t * type_supports);
+
+/// @brief Presizes the bounded strings and sequences of a message to their upper bounds
+/// Deserializing into a reused message does not allocate as long as its capacity suffices,
+/// which is always the case for bounded types after calling this. Only the fields of the plan
+/// are visited and only those below their upper bound are reserved, so calling it before each
+/// take is cheap once the message is presized.
+/// @throws std::bad_alloc if the storage can't be allocated
+void reserve_message(const ReservePlan & plan, void * ros_message);
+
+/// @brief Presizes a message without a plan of its type, see above
+/// @throws std::bad_alloc if the storage can't be allocated
+void reserve_message(
+  const rosidl_message_type_support_t * type_supports,
+  void * ros_message);
+
 }  // namespace rmw_iceoryx_cpp
 #endif  // RMW_ICEORYX_CPP__ICEORYX_DESERIALIZE_HPP_
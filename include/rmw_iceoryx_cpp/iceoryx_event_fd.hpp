@@ -0,0 +1,35 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RMW_ICEORYX_CPP__ICEORYX_EVENT_FD_HPP_
+#define RMW_ICEORYX_CPP__ICEORYX_EVENT_FD_HPP_
+
+#include "rmw/types.h"
+
+namespace rmw_iceoryx_cpp
+{
+
+/// @brief Event file descriptor which becomes readable when the subscription receives data
+/// The descriptor is a non-blocking eventfd which can be added to an epoll loop. Reading it
+/// resets it, all messages available afterwards have to be taken before waiting on it again.
+/// The descriptor is owned by the subscription and closed when the subscription is destroyed.
+/// @note The subscription is attached to a listener shared by all event file descriptors of the
+/// process, it must not be waited on with rmw_wait anymore, rmw_wait fails with RMW_RET_ERROR.
+rmw_ret_t get_subscription_event_fd(const rmw_subscription_t * subscription, int * fd);
+
+/// @brief Event file descriptor which becomes readable when the guard condition is triggered
+/// @see get_subscription_event_fd
+rmw_ret_t get_guard_condition_event_fd(const rmw_guard_condition_t * guard_condition, int * fd);
+
+}  // namespace rmw_iceoryx_cpp
+#endif  // RMW_ICEORYX_CPP__ICEORYX_EVENT_FD_HPP_
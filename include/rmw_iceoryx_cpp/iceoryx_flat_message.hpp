@@ -0,0 +1,58 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_ICEORYX_CPP__ICEORYX_FLAT_MESSAGE_HPP_
+#define RMW_ICEORYX_CPP__ICEORYX_FLAT_MESSAGE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+struct rosidl_message_type_support_t;
+
+namespace rmw_iceoryx_cpp
+{
+
+/// @brief Whether messages of this type can be loaned with the flat layout
+/// This is the case for C messages whose strings and sequences are all bounded. Their storage is
+/// placed in the same chunk behind the message, so the message can be published without
+/// serialization. C++ messages use std::vector and std::string and can't be placed in a chunk.
+bool iceoryx_is_flat_type(const rosidl_message_type_support_t * type_supports);
+
+/// @brief Size of a chunk holding a flat message including the storage of its upper bounds
+size_t iceoryx_get_flat_message_size(const rosidl_message_type_support_t * type_supports);
+
+/// @brief Initializes a flat message in a loaned chunk
+/// The message is initialized with its default values, afterwards the data of all strings and
+/// sequences points to their storage in the chunk with the upper bound as capacity.
+/// Strings and sequences must not be reallocated by the user, only resized within the capacity.
+void iceoryx_init_flat_message(
+  const rosidl_message_type_support_t * type_supports,
+  void * chunk);
+
+/// @brief Replaces the data pointers of the flat message with their offset in the chunk
+/// @throws std::runtime_error if data was reallocated outside of the chunk
+void iceoryx_relocate_flat_message(
+  const rosidl_message_type_support_t * type_supports,
+  void * chunk);
+
+/// @brief Converts a received flat message into the serialized format
+/// The type support may be of either language, the layout is computed from the introspection.
+void iceoryx_flat_to_serialized(
+  const void * chunk,
+  size_t chunk_size,
+  const rosidl_message_type_support_t * type_supports,
+  std::vector<char> & serialized_msg);
+
+}  // namespace rmw_iceoryx_cpp
+#endif  // RMW_ICEORYX_CPP__ICEORYX_FLAT_MESSAGE_HPP_
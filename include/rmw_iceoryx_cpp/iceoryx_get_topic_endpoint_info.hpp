@@ -26,6 +26,8 @@
 #include "rmw/rmw.h"
 #include "rmw/topic_endpoint_info_array.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
+
 namespace rmw_iceoryx_cpp
 {
 /**
@@ -82,5 +84,23 @@ fill_rmw_subscriber_end_info(
   const std::tuple<std::string, std::vector<std::string>> & iceoryx_topic_endpoint_info_array,
   rcutils_allocator_t * allocator);
 
+/**
+ * \brief    Fills the endpoints of one topic straight from the graph, including the gids of
+ *           the publishers. To be called from within GraphCache::read()
+ * \param    rmw_topic_endpoint_info_array
+ * \param    graph
+ * \param    topic_name
+ * \param    endpoint_type
+ * \param    allocator
+ * \return   rmw_ret_t
+ */
+rmw_ret_t
+fill_rmw_end_info(
+  rmw_topic_endpoint_info_array_t * rmw_topic_endpoint_info_array,
+  const GraphCache::Graph & graph,
+  const char * topic_name,
+  rmw_endpoint_type_t endpoint_type,
+  rcutils_allocator_t * allocator);
+
 }  // namespace rmw_iceoryx_cpp
 #endif  // RMW_ICEORYX_CPP__ICEORYX_GET_TOPIC_ENDPOINT_INFO_HPP_
@@ -0,0 +1,356 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_ICEORYX_CPP__ICEORYX_GRAPH_CACHE_HPP_
+#define RMW_ICEORYX_CPP__ICEORYX_GRAPH_CACHE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace iox
+{
+namespace roudi
+{
+struct PortIntrospectionFieldTopic;
+struct ProcessIntrospectionFieldTopic;
+}  // namespace roudi
+}  // namespace iox
+
+namespace rmw_iceoryx_cpp
+{
+
+/// @brief Stores each distinct string once and identifies it by a dense id
+/// Looking up a known string does not allocate. Strings are never removed, the table grows with
+/// the number of distinct names seen by the process.
+class NameTable
+{
+public:
+  using Id = uint32_t;
+  static constexpr Id INVALID_ID = UINT32_MAX;
+
+  /// @return the id of name, which is added if it is unknown
+  Id intern(const char * name);
+  Id intern(const std::string & name)
+  {
+    return intern(name.c_str());
+  }
+
+  /// @return the id of name or INVALID_ID if it is unknown
+  Id find(const char * name) const;
+  Id find(const std::string & name) const
+  {
+    return find(name.c_str());
+  }
+
+  const std::string & name(Id id) const
+  {
+    return names_[id];
+  }
+
+  size_t size() const
+  {
+    return names_.size();
+  }
+
+private:
+  /// refers to a string of names_ or to the string looked up
+  struct NameRef
+  {
+    const char * data;
+    size_t size;
+
+    bool operator==(const NameRef & other) const
+    {
+      return size == other.size && 0 == std::memcmp(data, other.data, size);
+    }
+  };
+
+  struct NameRefHash
+  {
+    size_t operator()(const NameRef & name) const;
+  };
+
+  /// a deque keeps the strings in place when it grows
+  std::deque<std::string> names_;
+  std::unordered_map<NameRef, Id, NameRefHash> ids_;
+};
+
+/// @brief Topics, types and endpoints of the iceoryx graph, built from the port introspection
+/// Only the ports which changed since the last introspection sample are applied to the graph,
+/// queries read it in place instead of copying it.
+class GraphCache
+{
+public:
+  using Id = NameTable::Id;
+
+  struct Endpoint
+  {
+    Id node{NameTable::INVALID_ID};
+    /// unique id of a publisher port, the data of its gid, see iceoryx_generate_gid.hpp
+    /// 0 for subscribers, their ids are not part of the introspection
+    uint64_t port_id{0u};
+  };
+
+  struct Topic
+  {
+    Id type{NameTable::INVALID_ID};
+    std::vector<Endpoint> publishers;
+    std::vector<Endpoint> subscribers;
+  };
+
+  struct Node
+  {
+    /// the parts of the full name, interned once for the endpoint info
+    Id name{NameTable::INVALID_ID};
+    Id namespace_{NameTable::INVALID_ID};
+    /// topic of each publisher of the node
+    std::vector<Id> publishers;
+    /// topic of each subscriber of the node
+    std::vector<Id> subscribers;
+  };
+
+  /// @brief A node of the process introspection, split up for rmw_get_node_names
+  struct NodeName
+  {
+    Id full_name{NameTable::INVALID_ID};
+    Id name{NameTable::INVALID_ID};
+    Id namespace_{NameTable::INVALID_ID};
+    /// iceoryx has no security enclaves, all nodes are reported in the default enclave "/"
+    Id enclave{NameTable::INVALID_ID};
+  };
+
+  struct Graph
+  {
+    /// names of the topics, types and nodes
+    NameTable names;
+    /// topics with at least one endpoint
+    std::unordered_map<Id, Topic> topics;
+    /// nodes with at least one endpoint
+    std::unordered_map<Id, Node> nodes;
+    /// nodes of all processes sorted by their full name, only rebuilt when the nodes change
+    std::vector<NodeName> node_names;
+    /// type of each service with a server or client, derived from the request topics, which are
+    /// not part of the topics
+    std::unordered_map<Id, Id> services;
+
+    /// @return the topic or nullptr if it has no endpoints
+    const Topic * find_topic(const std::string & topic_name) const
+    {
+      return find(topics, topic_name);
+    }
+
+    /// @return the node or nullptr if it has no endpoints
+    const Node * find_node(const std::string & node_full_name) const
+    {
+      return find(nodes, node_full_name);
+    }
+
+  private:
+    template<typename MapT>
+    const typename MapT::mapped_type * find(const MapT & map, const std::string & name) const
+    {
+      auto id = names.find(name);
+      if (NameTable::INVALID_ID == id) {
+        return nullptr;
+      }
+      auto entry = map.find(id);
+      return (entry == map.end()) ? nullptr : &entry->second;
+    }
+  };
+
+  /// @brief A single change applied to the graph by an update
+  struct GraphChange
+  {
+    enum class Kind : uint8_t
+    {
+      PUBLISHER_ADDED,
+      PUBLISHER_REMOVED,
+      SUBSCRIBER_ADDED,
+      SUBSCRIBER_REMOVED,
+      /// the node got its first endpoint or appeared in the process introspection
+      NODE_APPEARED,
+      /// the node lost its last endpoint or vanished from the process introspection
+      NODE_VANISHED
+    };
+
+    Kind kind;
+    /// full name of the node
+    Id node;
+    /// INVALID_ID for the changes of nodes
+    Id topic;
+  };
+
+  /// @brief The changes applied to the graph by one or more updates
+  struct GraphDelta
+  {
+    /// generation() after the update
+    uint64_t generation{0u};
+    std::vector<GraphChange> changes;
+    /// sorted full names of the nodes owning a changed endpoint or an endpoint on a changed topic
+    std::vector<Id> affected_nodes;
+    /// true if a node appeared or vanished, which concerns every node
+    bool affects_all_nodes{false};
+
+    bool empty() const
+    {
+      return changes.empty();
+    }
+
+    /// @return true if the change concerns the node with the given full name
+    bool affects(Id node) const
+    {
+      return affects_all_nodes ||
+             std::binary_search(affected_nodes.begin(), affected_nodes.end(), node);
+    }
+  };
+
+  /// number of non-empty deltas kept for changes_since()
+  static constexpr size_t DELTA_HISTORY_SIZE = 64u;
+
+  /// @brief Applies the ports added and removed since the last introspection sample
+  /// @return the endpoints added and removed, the nodes which got their first or lost their last
+  /// endpoint
+  GraphDelta update(const iox::roudi::PortIntrospectionFieldTopic & port_sample);
+
+  /// @brief Replaces the node names with the ones of the process introspection sample
+  /// Only the nodes which are new since the last sample are split into name and namespace
+  /// @return the nodes which appeared or vanished
+  GraphDelta update(const iox::roudi::ProcessIntrospectionFieldTopic & process_sample);
+
+  /// @brief Collects the changes of the updates after the given generation, oldest first
+  /// @return false if the history does not reach back to generation, the graph has to be read
+  /// in full then
+  bool changes_since(uint64_t generation, std::vector<GraphChange> & changes) const;
+
+  /// @brief Merges the deltas of the updates after the given generation into delta
+  /// Each consumer of the deltas keeps its own generation, so none of them misses a change which
+  /// was applied by another one.
+  /// @return false if the history does not reach back to generation, delta then affects all nodes
+  bool delta_since(uint64_t generation, GraphDelta & delta) const;
+
+  /// @return the id of name in the names of the graph, which is added if it is unknown
+  Id intern(const std::string & name);
+
+  /// @brief Blocks until a port and a process introspection sample were applied
+  /// @return false if the timeout elapsed before
+  bool wait_until_ready(std::chrono::nanoseconds timeout) const;
+
+  /// @return the publishers of a topic, two hash lookups
+  size_t count_publishers(const std::string & topic_name) const;
+
+  /// @return the subscribers of a topic, two hash lookups
+  size_t count_subscribers(const std::string & topic_name) const;
+
+  /// @brief Incremented with each update, 0 as long as the cache is empty
+  uint64_t generation() const
+  {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  /// @brief Calls reader with the graph, which is not updated until reader returns
+  /// @return the return value of reader
+  template<typename ReaderT>
+  auto read(ReaderT && reader) const -> decltype(reader(std::declval<const Graph &>()))
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reader(graph_);
+  }
+
+  /// identifies a port of an introspection sample by the interned parts of its name
+  struct Port
+  {
+    Id node;
+    Id service;
+    Id instance;
+    Id event;
+    /// distinguishes publishers with the same name
+    uint64_t port_id;
+
+    bool operator==(const Port & other) const
+    {
+      return node == other.node && service == other.service && instance == other.instance &&
+             event == other.event && port_id == other.port_id;
+    }
+  };
+
+  struct PortHash
+  {
+    size_t operator()(const Port & port) const;
+  };
+
+  /// number of ports with the same name, iceoryx allows several of them per node
+  using PortCounts = std::unordered_map<Port, size_t, PortHash>;
+
+private:
+  /// @brief Sets the generation of delta and keeps it in the history if it is not empty
+  void record_delta(GraphDelta & delta);
+
+  mutable std::mutex mutex_;
+  Graph graph_;
+  /// ports of the last introspection sample, the next sample is compared with them
+  PortCounts publisher_ports_;
+  PortCounts subscriber_ports_;
+  /// ports of the request and response topics, the services are only rebuilt when they change
+  PortCounts service_ports_;
+  /// sorted full names of the nodes of the last process introspection sample
+  std::vector<Id> process_nodes_;
+  /// the last non-empty deltas, oldest first
+  std::deque<GraphDelta> history_;
+  /// generation of the newest delta which was dropped from history_
+  uint64_t dropped_generation_{0u};
+  std::atomic<uint64_t> generation_{0u};
+  /// notified when the first samples were applied
+  mutable std::condition_variable ready_condition_;
+  bool has_ports_{false};
+  bool has_processes_{false};
+  std::atomic<bool> is_ready_{false};
+};
+
+/// @brief The graph cache of the process
+/// The cache is filled in the background by the graph change notifier of the context, which
+/// subscribes to the introspection at rmw_init. The first call of the process blocks until an
+/// introspection sample arrived, at most 5 s. Later calls never block, even if it timed out.
+const GraphCache & get_graph_cache();
+
+/// @brief Applies an introspection sample to the graph cache of the process
+/// Several contexts apply the same samples, only the first one gets the changes returned. Use
+/// graph_delta_since() to get the changes since a generation.
+void update_graph_cache(const iox::roudi::PortIntrospectionFieldTopic & port_sample);
+void update_graph_cache(const iox::roudi::ProcessIntrospectionFieldTopic & process_sample);
+
+/// @brief GraphCache::delta_since() of the graph cache of the process, without waiting for the
+/// introspection
+bool graph_delta_since(uint64_t generation, GraphCache::GraphDelta & delta);
+
+/// @brief Environment variable which limits the graph guard conditions triggered by a change
+/// By default every graph change triggers the graph guard condition of every node, as the rmw
+/// API requires. If it is set to 1, a change of endpoints only triggers the nodes which
+/// GraphCache::GraphDelta::affects(), nodes watching topics without endpoints on them miss it.
+constexpr const char GRAPH_CHANGE_FILTERING_ENV_VAR[] = "RMW_ICEORYX_GRAPH_CHANGE_FILTERING";
+
+/// @brief Interns a name in the graph cache of the process, without waiting for the introspection
+GraphCache::Id intern_graph_name(const std::string & name);
+
+}  // namespace rmw_iceoryx_cpp
+#endif  // RMW_ICEORYX_CPP__ICEORYX_GRAPH_CACHE_HPP_
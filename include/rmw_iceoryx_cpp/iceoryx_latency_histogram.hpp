@@ -0,0 +1,142 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_ICEORYX_CPP__ICEORYX_LATENCY_HISTOGRAM_HPP_
+#define RMW_ICEORYX_CPP__ICEORYX_LATENCY_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "rmw/types.h"
+
+namespace rmw_iceoryx_cpp
+{
+
+/// @brief Lock-free histogram of latencies with power of two buckets
+/// Bucket 0 counts latencies <= 0ns, bucket i counts latencies in [2^(i-1), 2^i) nanoseconds.
+/// Recording is wait-free apart from the maximum, so it can be done on every take.
+class LatencyHistogram
+{
+public:
+  static constexpr size_t BUCKET_COUNT = 64u;
+
+  struct Snapshot
+  {
+    std::array<uint64_t, BUCKET_COUNT> buckets{};
+    uint64_t count{0u};
+    uint64_t sum_ns{0u};
+    uint64_t max_ns{0u};
+
+    /// @return exclusive upper bound of the bucket which contains the given quantile in [0, 1]
+    uint64_t quantile_upper_bound_ns(double quantile) const
+    {
+      const double rank = quantile * static_cast<double>(count);
+      uint64_t accumulated = 0u;
+      for (size_t index = 0u; index < BUCKET_COUNT; ++index) {
+        accumulated += buckets[index];
+        if (accumulated > 0u && static_cast<double>(accumulated) >= rank) {
+          return bucket_upper_bound_ns(index);
+        }
+      }
+      return bucket_upper_bound_ns(BUCKET_COUNT - 1u);
+    }
+  };
+
+  LatencyHistogram()
+  {
+    reset();
+  }
+
+  static size_t bucket_index(int64_t latency_ns)
+  {
+    uint64_t value = latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0u;
+    size_t index = 0u;
+    while (value > 0u) {
+      ++index;
+      value >>= 1u;
+    }
+    if (index >= BUCKET_COUNT) {
+      index = BUCKET_COUNT - 1u;
+    }
+    return index;
+  }
+
+  static uint64_t bucket_upper_bound_ns(size_t index)
+  {
+    return index == 0u ? 1u : uint64_t{1u} << index;
+  }
+
+  void record(int64_t latency_ns)
+  {
+    buckets_[bucket_index(latency_ns)].fetch_add(1u, std::memory_order_relaxed);
+    count_.fetch_add(1u, std::memory_order_relaxed);
+
+    // clock adjustments between the processes can result in negative latencies
+    const uint64_t value = latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0u;
+    sum_ns_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+    while (value > max_ns &&
+      !max_ns_.compare_exchange_weak(max_ns, value, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  /// @note the fields are read one after another, concurrent records might be partially included
+  Snapshot snapshot() const
+  {
+    Snapshot snapshot;
+    for (size_t index = 0u; index < BUCKET_COUNT; ++index) {
+      snapshot.buckets[index] = buckets_[index].load(std::memory_order_relaxed);
+    }
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+    snapshot.max_ns = max_ns_.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+  void reset()
+  {
+    for (auto & bucket : buckets_) {
+      bucket.store(0u, std::memory_order_relaxed);
+    }
+    count_.store(0u, std::memory_order_relaxed);
+    sum_ns_.store(0u, std::memory_order_relaxed);
+    max_ns_.store(0u, std::memory_order_relaxed);
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_ns_;
+  std::atomic<uint64_t> max_ns_;
+};
+
+/// @brief Environment variable which enables the latency statistics of the subscriptions
+/// The publish-to-take latency is only recorded for subscriptions created while it is set to 1.
+constexpr const char LATENCY_STATISTICS_ENV_VAR[] = "RMW_ICEORYX_LATENCY_STATISTICS";
+
+/// @brief Publish-to-take latencies of the messages taken by a subscription so far
+/// The latency is the difference of the system time at take and at publish.
+/// @return RMW_RET_UNSUPPORTED if the latency statistics are not enabled for the subscription
+rmw_ret_t get_latency_histogram(
+  const rmw_subscription_t * subscription,
+  LatencyHistogram::Snapshot * snapshot);
+
+/// @brief Clears the latency statistics of a subscription
+rmw_ret_t reset_latency_histogram(const rmw_subscription_t * subscription);
+
+}  // namespace rmw_iceoryx_cpp
+#endif  // RMW_ICEORYX_CPP__ICEORYX_LATENCY_HISTOGRAM_HPP_
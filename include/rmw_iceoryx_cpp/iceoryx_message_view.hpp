@@ -0,0 +1,156 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_ICEORYX_CPP__ICEORYX_MESSAGE_VIEW_HPP_
+#define RMW_ICEORYX_CPP__ICEORYX_MESSAGE_VIEW_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rmw/types.h"
+
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
+
+struct rosidl_message_type_support_t;
+
+namespace rmw_iceoryx_cpp
+{
+
+/// @brief How a message is represented in the user payload of a chunk
+enum class PayloadLayout
+{
+  /// serialized with rmw_iceoryx_cpp::serialize
+  SERIALIZED,
+  /// plain copy of a fixed size message
+  FIXED_SIZE,
+  /// relocated flat message, see iceoryx_flat_message.hpp
+  FLAT
+};
+
+/// @brief Read-only view on a received message which is not deserialized
+/// The fields of the message are indexed in a single pass over the payload with the help of the
+/// introspection type support, the accessors return pointers into the payload.
+/// @note The serialized format is not aligned, pointers to multi-byte elements might be unaligned
+class MessageView
+{
+public:
+  struct Field
+  {
+    const char * name{nullptr};
+    uint8_t type_id{0};
+    /// true for fixed size arrays and (bounded) sequences
+    bool is_array{false};
+    /// first element of the field in the payload, for strings the first character
+    const char * data{nullptr};
+    /// number of elements, for strings the number of characters
+    size_t size{0};
+    /// size of a single element in the payload, 0 if the elements have a variable size
+    size_t element_size{0};
+    /// introspection members if the field is a nested message
+    const void * sub_members{nullptr};
+  };
+
+  MessageView() = default;
+
+  /// @brief Indexes the fields of the payload
+  /// @param payload user payload of a chunk as written by rmw_publish
+  /// @param payload_size size of the user payload
+  /// @param type_supports type support of the subscription
+  /// @param layout representation of the message in the payload
+  /// @throws std::runtime_error if the payload does not match the type support
+  MessageView(
+    const void * payload,
+    size_t payload_size,
+    const rosidl_message_type_support_t * type_supports,
+    PayloadLayout layout);
+
+  bool is_valid() const
+  {
+    return payload_ != nullptr;
+  }
+
+  const void * payload() const
+  {
+    return payload_;
+  }
+
+  size_t field_count() const
+  {
+    return fields_.size();
+  }
+
+  /// @throws std::out_of_range if index is not a valid field index
+  const Field & field(size_t index) const
+  {
+    return fields_.at(index);
+  }
+
+  /// @return the index of the field with the given name or field_count() if there is none
+  size_t field_index(const std::string & name) const;
+
+  /// @brief Access to a primitive field, fixed size array or sequence
+  /// @return pointer to the first element and the number of elements
+  /// @throws std::runtime_error if T does not match the element size of the field
+  template<typename T>
+  std::pair<const T *, size_t> get_sequence(size_t index) const
+  {
+    const Field & f = field(index);
+    if (f.element_size != sizeof(T)) {
+      throw std::runtime_error(std::string("element size mismatch for field ") + f.name);
+    }
+    return std::make_pair(reinterpret_cast<const T *>(f.data), f.size);
+  }
+
+  /// @brief Access to a (non-array) string field
+  /// @return pointer to the first character and the length of the string, not null terminated
+  std::pair<const char *, size_t> get_string(size_t index) const;
+
+  /// @brief Access to a nested (non-array) message field
+  MessageView get_message(size_t index) const;
+
+private:
+  MessageView(
+    const MessageView & parent,
+    const void * message,
+    const void * members);
+
+  void index_fields(const void * members);
+
+  const char * payload_{nullptr};
+  /// flat messages refer to their strings and sequences by the offset to the begin of the chunk
+  const char * chunk_{nullptr};
+  size_t chunk_size_{0};
+  TypeSupportLanguage language_{TypeSupportLanguage::CPP};
+  PayloadLayout layout_{PayloadLayout::SERIALIZED};
+  std::vector<Field> fields_;
+};
+
+/// @brief Takes a chunk from the subscription and provides a view on it instead of deserializing
+/// The chunk stays loaned until it is handed back with return_message_view()
+rmw_ret_t take_message_view(
+  const rmw_subscription_t * subscription,
+  MessageView * message_view,
+  bool * taken);
+
+/// @brief Releases the chunk underlying the view and invalidates the view
+rmw_ret_t return_message_view(
+  const rmw_subscription_t * subscription,
+  MessageView * message_view);
+
+}  // namespace rmw_iceoryx_cpp
+#endif  // RMW_ICEORYX_CPP__ICEORYX_MESSAGE_VIEW_HPP_
@@ -71,5 +71,53 @@ get_iceoryx_service_description(
   const std::string & topic,
   const rosidl_message_type_support_t * type_supports);
 
+/// Check if an iceoryx instance carries the requests or responses of a ROS service.
+/**
+ * The request and response topics are not fully qualified ROS topic names, the graph hides them.
+ * \param instance the iceoryx instance description
+ * \return true for `rq<service_name>Request` and `rr<service_name>Reply`
+ */
+bool
+is_service_instance(const char * instance);
+
+/// Get the name and type of a ROS service from the iceoryx description of its requests.
+/**
+ * \param service the iceoryx service description, which holds the request type
+ * \param instance the iceoryx instance description `rq<service_name>Request`
+ * \return tuple of service name and type, two empty strings if the description is not the one
+ * of a request topic
+ */
+std::tuple<std::string, std::string>
+get_service_name_n_type_from_request_description(
+  const std::string & service,
+  const std::string & instance);
+
+/// Get the iceoryx service description of the requests to a ROS service.
+/**
+ * The requests are sent on the topic `rq<service_name>Request`.
+ * \param service_name the name of the ROS service
+ * \param request_type_supports type support of the request message
+ * \return the iceoryx service description
+ */
+iox::capro::ServiceDescription
+get_iceoryx_request_service_description(
+  const std::string & service_name,
+  const rosidl_message_type_support_t * request_type_supports);
+
+/// Get the iceoryx service description of the responses of a ROS service to a single client.
+/**
+ * The responses are sent on the topic `rr<service_name>Reply`, the iceoryx event field holds
+ * the id of the client instead of "data".
+ * \param service_name the name of the ROS service
+ * \param response_type_supports type support of the response message
+ * \param client_id printable id of the client
+ * \return the iceoryx service description
+ */
+iox::capro::ServiceDescription
+get_iceoryx_response_service_description(
+  const std::string & service_name,
+  const rosidl_message_type_support_t * response_type_supports,
+  const std::string & client_id);
+
 }  // namespace rmw_iceoryx_cpp
 #endif  // RMW_ICEORYX_CPP__ICEORYX_NAME_CONVERSION_HPP_
@@ -0,0 +1,35 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_ICEORYX_CPP__ICEORYX_PUBLISHER_STATISTICS_HPP_
+#define RMW_ICEORYX_CPP__ICEORYX_PUBLISHER_STATISTICS_HPP_
+
+#include <cstdint>
+
+#include "rmw/types.h"
+
+namespace rmw_iceoryx_cpp
+{
+
+/// @brief Number of messages which were dropped by rmw_publish as the publisher had no subscribers
+/// These messages were neither serialized nor copied into a chunk.
+rmw_ret_t get_skipped_publish_count(const rmw_publisher_t * publisher, uint64_t * count);
+
+/// @brief Number of chunks the publisher failed to loan
+/// Subscribers which are too slow keep their chunks, which exhausts the chunks a publisher may
+/// hold or the memory pool. The publish calls which failed because of this return an error.
+rmw_ret_t get_failed_loan_count(const rmw_publisher_t * publisher, uint64_t * count);
+
+}  // namespace rmw_iceoryx_cpp
+#endif  // RMW_ICEORYX_CPP__ICEORYX_PUBLISHER_STATISTICS_HPP_
@@ -15,6 +15,7 @@
 #ifndef RMW_ICEORYX_CPP__ICEORYX_SERIALIZE_HPP_
 #define RMW_ICEORYX_CPP__ICEORYX_SERIALIZE_HPP_
 
+#include <cstddef>
 #include <vector>
 
 struct rosidl_message_type_support_t;
@@ -27,5 +28,9 @@ void serialize(
   const rosidl_message_type_support_t * type_supports,
   std::vector<char> & payload_vector);
 
+/// @brief Size of the largest possible serialized message of a type
+/// @return the upper bound or 0 if the type contains unbounded strings or sequences
+size_t get_serialized_size_upper_bound(const rosidl_message_type_support_t * type_supports);
+
 }  // namespace rmw_iceoryx_cpp
 #endif  // RMW_ICEORYX_CPP__ICEORYX_SERIALIZE_HPP_
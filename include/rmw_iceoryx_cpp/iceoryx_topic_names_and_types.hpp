@@ -24,9 +24,13 @@
 #include "rmw/names_and_types.h"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
+
 namespace rmw_iceoryx_cpp
 {
 
+/// @brief Copies the containers of the graph cache
+/// @note Prefer reading the graph in place with get_graph_cache(), see iceoryx_graph_cache.hpp
 void fill_topic_containers(
   std::map<std::string, std::string> & names_n_types_,
   std::map<std::string, std::vector<std::string>> & subscribers_topics_,
@@ -53,5 +57,19 @@ rmw_ret_t fill_rmw_names_and_types(
   const std::map<std::string, std::string> & iceoryx_topic_names_and_types,
   rcutils_allocator_t * allocator);
 
+/// @brief Fills the topics of the graph without copying them first
+/// @note To be called from within GraphCache::read()
+rmw_ret_t fill_rmw_names_and_types(
+  rmw_names_and_types_t * rmw_topic_names_and_types,
+  const GraphCache::Graph & graph,
+  rcutils_allocator_t * allocator);
+
+/// @brief Fills the services of the graph, see GraphCache::Graph::services
+/// @note To be called from within GraphCache::read()
+rmw_ret_t fill_rmw_service_names_and_types(
+  rmw_names_and_types_t * rmw_service_names_and_types,
+  const GraphCache::Graph & graph,
+  rcutils_allocator_t * allocator);
+
 }  // namespace rmw_iceoryx_cpp
 #endif  // RMW_ICEORYX_CPP__ICEORYX_TOPIC_NAMES_AND_TYPES_HPP_
@@ -20,6 +20,7 @@
 #include <utility>
 
 struct rosidl_message_type_support_t;
+struct rosidl_service_type_support_t;
 
 namespace rmw_iceoryx_cpp
 {
@@ -30,6 +31,27 @@ enum class TypeSupportLanguage
   C
 };
 
+/// @brief Properties of a message type, resolved once per type
+struct TypeInfo
+{
+  TypeSupportLanguage language;
+  /// introspection type support of language
+  const rosidl_message_type_support_t * introspection_type_supports;
+  /// introspection MessageMembers of language
+  const void * members;
+  bool is_fixed_size;
+  size_t size;
+  std::string name;
+  std::string namespace_;
+};
+
+/// @brief Looks up the type in the type registry of the process
+/// The registry is keyed by the introspection members of the types, the type support of a type is
+/// only resolved with get_message_typesupport_handle() when the type is looked up the first time.
+/// Entries are never removed, the reference stays valid.
+/// @throws std::runtime_error if there is neither a C nor a CPP introspection type support
+const TypeInfo & iceoryx_get_type_info(const rosidl_message_type_support_t * type_supports);
+
 /// @brief Wraps get_message_typesupport_handle() and does error handling
 /// @return std::pair containing enum TypeSupportLanguage and handle to the type support
 const std::pair<TypeSupportLanguage, const rosidl_message_type_support_t *> get_type_support(
@@ -53,5 +75,13 @@ void iceoryx_fini_message(
   const rosidl_message_type_support_t * type_supports,
   void * message);
 
+/// @brief Message type supports of the request and the response of a service
+/// The message type supports refer to the introspection members of the service type support.
+/// @throws std::runtime_error if the service has neither C nor CPP introspection type support
+void iceoryx_get_service_message_type_supports(
+  const rosidl_service_type_support_t * type_supports,
+  rosidl_message_type_support_t * request_type_supports,
+  rosidl_message_type_support_t * response_type_supports);
+
 }  // namespace rmw_iceoryx_cpp
 #endif  // RMW_ICEORYX_CPP__ICEORYX_TYPE_INFO_INTROSPECTION_HPP_
@@ -0,0 +1,47 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_ICEORYX_CPP__ICEORYX_WAIT_SPIN_HPP_
+#define RMW_ICEORYX_CPP__ICEORYX_WAIT_SPIN_HPP_
+
+#include <cstdint>
+
+#include "rmw/types.h"
+
+namespace rmw_iceoryx_cpp
+{
+
+/// @brief Environment variable with the default spin duration of new wait sets in microseconds
+/// Wait sets created while it is unset or 0 block right away.
+constexpr const char WAIT_SPIN_DURATION_ENV_VAR[] = "RMW_ICEORYX_WAIT_SPIN_US";
+
+/// @brief Number of rmw_wait calls which spun and how many of them found data while spinning
+struct WaitSpinStatistics
+{
+  uint64_t spin_count{0u};
+  uint64_t spin_success_count{0u};
+};
+
+/// @brief Lets rmw_wait busy-poll the subscriptions before it blocks on the iceoryx WaitSet
+/// Spinning avoids the wake-up latency of a blocking wait at the cost of a busy core. Guard
+/// conditions are only noticed by the blocking wait, which follows the spin phase.
+/// @param spin_duration_us upper bound of the spin phase, 0 disables spinning
+rmw_ret_t set_wait_spin_duration(rmw_wait_set_t * wait_set, uint64_t spin_duration_us);
+
+rmw_ret_t get_wait_spin_statistics(
+  const rmw_wait_set_t * wait_set,
+  WaitSpinStatistics * statistics);
+
+}  // namespace rmw_iceoryx_cpp
+#endif  // RMW_ICEORYX_CPP__ICEORYX_WAIT_SPIN_HPP_
@@ -0,0 +1,25 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef ICEORYX_EVENT_FD_HPP_
+#define ICEORYX_EVENT_FD_HPP_
+
+#include "iceoryx_posh/popo/user_trigger.hpp"
+
+#include "./types/iceoryx_subscription.hpp"
+
+/// @brief Detaches the entity from the event fd listener and closes its event fd, if it has one
+void release_event_fd(IceoryxSubscription * iceoryx_subscription);
+void release_event_fd(iox::popo::UserTrigger * iceoryx_guard_condition);
+
+#endif  // ICEORYX_EVENT_FD_HPP_
@@ -16,10 +16,15 @@
 #ifndef ICEORYX_GENERATE_GID_HPP_
 #define ICEORYX_GENERATE_GID_HPP_
 
+#include <cstdint>
+
 #include "rmw/types.h"
 
 #include "iceoryx_posh/popo/untyped_publisher.hpp"
 
 rmw_gid_t generate_publisher_gid(iox::popo::UntypedPublisher * const publisher);
 
+/// @brief The gid of the publisher with the given unique port id, as reported by the introspection
+rmw_gid_t generate_publisher_gid(uint64_t publisher_port_id);
+
 #endif  // ICEORYX_GENERATE_GID_HPP_
@@ -0,0 +1,31 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ICEORYX_LISTENER_POOL_HPP_
+#define ICEORYX_LISTENER_POOL_HPP_
+
+#include <functional>
+
+#include "iceoryx_posh/popo/listener.hpp"
+
+/// @brief Attaches to the first listener of the process with space left, creates one if all are
+/// full
+/// The listeners are shared by the event fds and the wait sets which overflow, each listener runs
+/// a thread. They are created on demand and never destroyed, the callers detach their entities.
+/// @param attach called with a listener, returns false if the listener is full
+/// @return the listener attach succeeded with, nullptr if no listener could be created
+iox::popo::Listener * attach_to_listener_pool(
+  const std::function<bool(iox::popo::Listener &)> & attach);
+
+#endif  // ICEORYX_LISTENER_POOL_HPP_
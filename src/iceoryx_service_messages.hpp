@@ -0,0 +1,69 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ICEORYX_SERVICE_MESSAGES_HPP_
+#define ICEORYX_SERVICE_MESSAGES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "iceoryx_posh/popo/untyped_publisher.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+
+#include "rmw/types.h"
+
+struct IceoryxService;
+struct IceoryxServiceMessageType;
+
+/// number of bytes which identify a client, requests and responses carry them in the user header
+constexpr size_t CLIENT_ID_SIZE = sizeof(rmw_request_id_t::writer_guid);
+static_assert(CLIENT_ID_SIZE <= RMW_GID_STORAGE_SIZE, "client id has to fit into a gid");
+
+/// @brief Printable form of a client id, used as iceoryx event of the response topic
+std::string client_id_to_string(const int8_t * client_id);
+
+/// @brief Sends a request or response, the user header carries the client id and sequence number
+/// Fixed size messages are copied into the loaned chunk, all others are serialized into it.
+/// @note This is not zero-copy. rmw has no loan API for requests and responses, so the message of
+/// the caller is copied into the chunk with a single memcpy instead of being written in place.
+rmw_ret_t send_service_message(
+  iox::popo::UntypedPublisher * iceoryx_sender,
+  const IceoryxServiceMessageType & message_type,
+  const void * ros_message,
+  const int8_t * client_id,
+  int64_t sequence_number);
+
+/// @brief Takes a request or response and fills the service info from the user header
+/// @note Fixed size messages are copied out of the chunk, see send_service_message()
+rmw_ret_t take_service_message(
+  iox::popo::UntypedSubscriber * iceoryx_receiver,
+  const IceoryxServiceMessageType & message_type,
+  void * ros_message,
+  rmw_service_info_t * service_info,
+  bool * taken);
+
+/// @brief Drops the publishers of the clients which are gone and, if there are still too many,
+/// the least recently used one, so short-lived clients do not accumulate RouDi ports
+/// @note The caller holds IceoryxService::response_senders_mutex_
+void drop_response_senders(IceoryxService * iceoryx_service);
+
+/// @brief Publisher of the responses to a client, created with the first request of the client
+/// The publisher keeps the last responses as history, so the client receives the responses which
+/// are sent before its subscriber is connected.
+/// @return nullptr if the publisher could not be created
+iox::popo::UntypedPublisher *
+get_response_sender(IceoryxService * iceoryx_service, const int8_t * client_id);
+
+#endif  // ICEORYX_SERVICE_MESSAGES_HPP_
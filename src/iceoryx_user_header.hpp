@@ -0,0 +1,67 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ICEORYX_USER_HEADER_HPP_
+#define ICEORYX_USER_HEADER_HPP_
+
+#include <cstdint>
+
+#include "iceoryx_posh/mepoo/chunk_header.hpp"
+
+#include "rmw/types.h"
+
+#include "rmw_iceoryx_cpp/iceoryx_message_view.hpp"
+
+/// Header in front of the user payload of the chunks sent by rmw_iceoryx_cpp
+struct IceoryxUserHeader
+{
+  /// flat messages have to be converted by the subscriber, see iceoryx_flat_message.hpp
+  bool is_flat{false};
+  /// data of the gid of the sending publisher, the implementation identifier is process local
+  uint8_t publisher_gid[RMW_GID_STORAGE_SIZE]{};
+  /// system time at which the message was published
+  rmw_time_point_value_t source_timestamp{0};
+  /// starts at 1 and is incremented with each message of the publisher
+  uint64_t sequence_number{0u};
+};
+
+inline const IceoryxUserHeader * get_user_header(const void * user_payload)
+{
+  auto chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(user_payload);
+  if (chunk_header->userHeaderId() == iox::mepoo::ChunkHeader::NO_USER_HEADER) {
+    return nullptr;
+  }
+  return static_cast<const IceoryxUserHeader *>(chunk_header->userHeader());
+}
+
+inline IceoryxUserHeader * get_user_header(void * user_payload)
+{
+  auto chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(user_payload);
+  return static_cast<IceoryxUserHeader *>(chunk_header->userHeader());
+}
+
+/// @brief Layout of a received payload, fixed size messages are sent as plain copy
+inline rmw_iceoryx_cpp::PayloadLayout get_payload_layout(
+  const void * user_payload,
+  bool is_fixed_size)
+{
+  auto user_header = get_user_header(user_payload);
+  if (user_header && user_header->is_flat) {
+    return rmw_iceoryx_cpp::PayloadLayout::FLAT;
+  }
+  return is_fixed_size ?
+         rmw_iceoryx_cpp::PayloadLayout::FIXED_SIZE : rmw_iceoryx_cpp::PayloadLayout::SERIALIZED;
+}
+
+#endif  // ICEORYX_USER_HEADER_HPP_
@@ -13,6 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <tuple>
+
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
 
 #include "rosidl_typesupport_introspection_c/identifier.h"
@@ -50,4 +52,40 @@ void deserialize(
   }
 }
 
+ReservePlan get_reserve_plan(const rosidl_message_type_support_t * type_supports)
+{
+  ReservePlan plan;
+  auto ts = get_type_support(type_supports);
+
+  if (ts.first == TypeSupportLanguage::CPP) {
+    auto members_cpp =
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
+    plan.is_cpp = true;
+    std::tie(plan.message_begin, plan.message_end) =
+      rmw_iceoryx_cpp::details_cpp::add_reserve_steps(members_cpp, plan);
+  } else if (ts.first == TypeSupportLanguage::C) {
+    auto members_c =
+      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
+    std::tie(plan.message_begin, plan.message_end) =
+      rmw_iceoryx_cpp::details_c::add_reserve_steps(members_c, plan);
+  }
+  return plan;
+}
+
+void reserve_message(const ReservePlan & plan, void * ros_message)
+{
+  if (plan.is_cpp) {
+    rmw_iceoryx_cpp::details_cpp::reserve(plan, plan.message_begin, plan.message_end, ros_message);
+  } else {
+    rmw_iceoryx_cpp::details_c::reserve(plan, plan.message_begin, plan.message_end, ros_message);
+  }
+}
+
+void reserve_message(
+  const rosidl_message_type_support_t * type_supports,
+  void * ros_message)
+{
+  reserve_message(get_reserve_plan(type_supports), ros_message);
+}
+
 }  // namespace rmw_iceoryx_cpp
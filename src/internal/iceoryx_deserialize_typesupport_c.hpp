@@ -17,17 +17,23 @@
 
 #include <array>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <new>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "rosidl_runtime_c/primitives_sequence.h"
 #include "rosidl_runtime_c/string_functions.h"
 
 #include "rosidl_typesupport_introspection_c/field_types.h"
 #include "rosidl_typesupport_introspection_c/message_introspection.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_deserialize.hpp"
+
 #include "./iceoryx_serialization_common.hpp"
 
 namespace rmw_iceoryx_cpp
@@ -59,8 +65,15 @@ const char * deserialize_element<rosidl_runtime_c__String, sizeof(rosidl_runtime
   std::tie(serialized_msg, string_size) = pop_sequence_size(serialized_msg);
 
   auto string = reinterpret_cast<rosidl_runtime_c__String *>(ros_message_field);
-  // valgrind reports a memory leak here
-  rosidl_runtime_c__String__assignn(string, serialized_msg, string_size);
+  if (string->data && string->capacity > string_size) {
+    // the message is reused, keep its storage
+    memcpy(string->data, serialized_msg, string_size);
+    string->data[string_size] = '\0';
+    string->size = string_size;
+  } else {
+    // valgrind reports a memory leak here
+    rosidl_runtime_c__String__assignn(string, serialized_msg, string_size);
+  }
   serialized_msg += string_size;
   return serialized_msg;
 }
@@ -79,43 +92,61 @@ const char * deserialize_array(
   return serialized_msg;
 }
 
-template<
-  class T,
-  size_t SizeT = sizeof(T)
->
-const char * deserialize_sequence(const char * serialized_msg, void * ros_message_field)
+/// @brief Grows the storage of a sequence, the existing elements are kept
+/// The sequence structs of the C type support only differ in the type of the data pointer
+/// @return the previous capacity, the elements from there on are zero initialized
+inline size_t reserve_sequence(void * ros_message_field, size_t capacity, size_t element_size)
 {
-  uint32_t array_size = 0;
-  std::tie(serialized_msg, array_size) = pop_sequence_size(serialized_msg);
+  auto sequence = reinterpret_cast<rosidl_runtime_c__uint8__Sequence *>(ros_message_field);
+  const size_t old_capacity = sequence->data ? sequence->capacity : 0u;
+  if (capacity <= old_capacity) {
+    return old_capacity;
+  }
 
-  if (array_size > 0) {
-    auto sequence = reinterpret_cast<typename traits::sequence_type<T>::type *>(ros_message_field);
-    sequence->data = static_cast<T *>(calloc(array_size, SizeT));
-    sequence->size = array_size;
-    sequence->capacity = array_size;
+  auto data = static_cast<uint8_t *>(realloc(sequence->data, capacity * element_size));
+  if (!data) {
+    throw std::bad_alloc();
+  }
+  memset(data + old_capacity * element_size, 0, (capacity - old_capacity) * element_size);
+  sequence->data = data;
+  sequence->capacity = capacity;
+  return old_capacity;
+}
 
-    return deserialize_array<T>(serialized_msg, sequence->data, array_size);
+/// @brief Grows the storage of a string to hold capacity - 1 characters, the content is kept
+inline void reserve_string(rosidl_runtime_c__String * string, size_t capacity)
+{
+  if (string->data && string->capacity >= capacity) {
+    return;
   }
-  return serialized_msg;
+
+  auto data = static_cast<char *>(realloc(string->data, capacity));
+  if (!data) {
+    throw std::bad_alloc();
+  }
+  if (!string->data) {
+    data[0] = '\0';
+    string->size = 0u;
+  }
+  string->data = data;
+  string->capacity = capacity;
 }
 
-template<>
-const char * deserialize_sequence<char, sizeof(char)>(
-  const char * serialized_msg,
-  void * ros_message_field)
+template<
+  class T,
+  size_t SizeT = sizeof(T)
+>
+const char * deserialize_sequence(const char * serialized_msg, void * ros_message_field)
 {
   uint32_t array_size = 0;
   std::tie(serialized_msg, array_size) = pop_sequence_size(serialized_msg);
 
-  if (array_size > 0) {
-    auto sequence = reinterpret_cast<rosidl_runtime_c__char__Sequence *>(ros_message_field);
-    sequence->data = static_cast<signed char *>(calloc(array_size, sizeof(char)));
-    sequence->size = array_size;
-    sequence->capacity = array_size;
+  // the capacity of a reused message is kept, so only growing sequences allocate
+  reserve_sequence(ros_message_field, array_size, SizeT);
+  auto sequence = reinterpret_cast<rosidl_runtime_c__uint8__Sequence *>(ros_message_field);
+  sequence->size = array_size;
 
-    return deserialize_array<char>(serialized_msg, sequence->data, array_size);
-  }
-  return serialized_msg;
+  return deserialize_array<T>(serialized_msg, sequence->data, array_size);
 }
 
 template<typename T>
@@ -218,10 +249,16 @@ const char * deserialize(
 
             std::tie(serialized_msg, sequence_size) = pop_sequence_size(serialized_msg);
 
+            // new elements have to be initialized, sequences are finalized up to their capacity
+            size_t initialized =
+              reserve_sequence(ros_message_field, sequence_size, sub_members_size);
             auto sequence =
-              const_cast<rosidl_runtime_c__char__Sequence *>(reinterpret_cast<const
-              rosidl_runtime_c__char__Sequence
-              *>(ros_message_field));
+              reinterpret_cast<rosidl_runtime_c__uint8__Sequence *>(ros_message_field);
+            for (size_t index = initialized; index < sequence_size; ++index) {
+              sub_members->init_function(
+                sequence->data + index * sub_members_size, ROSIDL_RUNTIME_C_MSG_INIT_ALL);
+            }
+            sequence->size = sequence_size;
 
             subros_message = reinterpret_cast<void *>(sequence->data);
           }
@@ -239,6 +276,138 @@ const char * deserialize(
   return serialized_msg;
 }
 
+/// @return the size of an element of a member, 0 for types which are not presized
+inline size_t get_reserve_element_size(
+  const rosidl_typesupport_introspection_c__MessageMember * member)
+{
+  if (member->type_id_ == ::rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+    return static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+      member->members_->data)->size_of_;
+  } else if (member->type_id_ == ::rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+    return sizeof(rosidl_runtime_c__String);
+  }
+  return get_primitive_size(member->type_id_);
+}
+
+/// @brief Appends the steps of a message type to the plan
+/// @return the range of the steps of the message in plan.steps
+std::pair<size_t, size_t> add_reserve_steps(
+  const rosidl_typesupport_introspection_c__MessageMembers * members,
+  ReservePlan & plan);
+
+/// @brief Collects the steps of the bounded fields, nested messages which are no sequences are
+/// flattened into the steps of the enclosing message
+void collect_reserve_steps(
+  const rosidl_typesupport_introspection_c__MessageMembers * members,
+  size_t base_offset,
+  std::vector<ReserveStep> & message_steps,
+  ReservePlan & plan)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    const size_t offset = base_offset + member->offset_;
+    const size_t element_size = get_reserve_element_size(member);
+    if (element_size == 0u) {
+      continue;
+    }
+    const bool is_sequence = member->is_array_ &&
+      (member->array_size_ == 0 || member->is_upper_bound_);
+
+    if (member->type_id_ == ::rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+      auto sub_members =
+        static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+        member->members_->data);
+      if (!member->is_array_) {
+        collect_reserve_steps(sub_members, offset, message_steps, plan);
+      } else if (!is_sequence) {
+        for (size_t index = 0; index < member->array_size_; ++index) {
+          collect_reserve_steps(sub_members, offset + index * element_size, message_steps, plan);
+        }
+      } else {
+        auto elements = add_reserve_steps(sub_members, plan);
+        if (member->is_upper_bound_ || elements.first != elements.second) {
+          message_steps.push_back({offset, member, elements.first, elements.second});
+        }
+      }
+    } else if (member->type_id_ == ::rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+      if (member->string_upper_bound_ > 0u || member->is_upper_bound_) {
+        message_steps.push_back({offset, member, 0u, 0u});
+      }
+    } else if (member->is_upper_bound_) {
+      message_steps.push_back({offset, member, 0u, 0u});
+    }
+  }
+}
+
+std::pair<size_t, size_t> add_reserve_steps(
+  const rosidl_typesupport_introspection_c__MessageMembers * members,
+  ReservePlan & plan)
+{
+  // the steps of sequence elements are appended while collecting, so the steps of the message
+  // are appended afterwards to keep them contiguous
+  std::vector<ReserveStep> message_steps;
+  collect_reserve_steps(members, 0u, message_steps, plan);
+  const size_t begin = plan.steps.size();
+  plan.steps.insert(plan.steps.end(), message_steps.begin(), message_steps.end());
+  return {begin, plan.steps.size()};
+}
+
+/// @brief Presizes the fields of the steps [begin, end) of a plan to their upper bounds
+/// Unbounded fields are left as they are, they keep the capacity of the largest message taken.
+void reserve(const ReservePlan & plan, size_t begin, size_t end, void * ros_message)
+{
+  for (size_t i = begin; i < end; ++i) {
+    const auto & step = plan.steps[i];
+    const auto * member =
+      static_cast<const rosidl_typesupport_introspection_c__MessageMember *>(step.member);
+    char * ros_message_field = static_cast<char *>(ros_message) + step.offset;
+    const size_t element_size = get_reserve_element_size(member);
+    const size_t string_capacity = member->string_upper_bound_ + 1u;
+
+    // only strings and sequences have steps of their own
+    if (!member->is_array_) {
+      reserve_string(
+        reinterpret_cast<rosidl_runtime_c__String *>(ros_message_field), string_capacity);
+      continue;
+    }
+    if (member->array_size_ > 0 && !member->is_upper_bound_) {
+      for (size_t index = 0; index < member->array_size_; ++index) {
+        reserve_string(
+          reinterpret_cast<rosidl_runtime_c__String *>(ros_message_field + index * element_size),
+          string_capacity);
+      }
+      continue;
+    }
+
+    auto sequence = reinterpret_cast<rosidl_runtime_c__uint8__Sequence *>(ros_message_field);
+    if (member->is_upper_bound_) {
+      size_t initialized = reserve_sequence(ros_message_field, member->array_size_, element_size);
+      if (member->type_id_ == ::rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+        auto sub_members =
+          static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+          member->members_->data);
+        for (size_t index = initialized; index < sequence->capacity; ++index) {
+          sub_members->init_function(
+            sequence->data + index * element_size, ROSIDL_RUNTIME_C_MSG_INIT_ALL);
+        }
+      }
+    }
+    if (get_primitive_size(member->type_id_) > 0u) {
+      continue;
+    }
+    // elements behind the size are reused by the deserialization as well
+    const size_t capacity = sequence->data ? sequence->capacity : 0u;
+    for (size_t index = 0; index < capacity; ++index) {
+      char * element = reinterpret_cast<char *>(sequence->data) + index * element_size;
+      if (member->type_id_ == ::rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+        reserve(plan, step.elements_begin, step.elements_end, element);
+      } else if (member->string_upper_bound_ > 0u) {
+        reserve_string(reinterpret_cast<rosidl_runtime_c__String *>(element), string_capacity);
+      }
+    }
+  }
+}
+
 }  // namespace details_c
 }  // namespace rmw_iceoryx_cpp
 #endif  // INTERNAL__ICEORYX_DESERIALIZE_TYPESUPPORT_C_HPP_
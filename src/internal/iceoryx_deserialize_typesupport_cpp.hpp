@@ -21,11 +21,14 @@
 #include <iostream>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "rosidl_typesupport_introspection_cpp/field_types.hpp"
 #include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
 
+#include "rmw_iceoryx_cpp/iceoryx_deserialize.hpp"
+
 #include "./iceoryx_serialization_common.hpp"
 
 namespace rmw_iceoryx_cpp
@@ -128,14 +131,13 @@ const char * deserialize_sequence(
 {
   uint32_t sequence_size = 0;
   std::tie(serialized_msg, sequence_size) = pop_sequence_size(serialized_msg);
-  if (sequence_size > 0) {
-    debug_log("deserializigng data sequence of size %zu\n", sequence_size);
-    auto sequence = reinterpret_cast<ContainerT *>(ros_message_field);
-    sequence->resize(sequence_size);
-    for (T & t : *sequence) {
-      char * data = reinterpret_cast<char *>(&t);
-      serialized_msg = deserialize_element<T>(serialized_msg, data);
-    }
+  debug_log("deserializigng data sequence of size %zu\n", sequence_size);
+  // empty sequences have to be resized as well when a message is reused, resize keeps the capacity
+  auto sequence = reinterpret_cast<ContainerT *>(ros_message_field);
+  sequence->resize(sequence_size);
+  for (T & t : *sequence) {
+    char * data = reinterpret_cast<char *>(&t);
+    serialized_msg = deserialize_element<T>(serialized_msg, data);
   }
   return serialized_msg;
 }
@@ -147,37 +149,31 @@ const char * deserialize_sequence<bool, sizeof(bool), std::vector<bool>>(
 {
   uint32_t sequence_size = 0;
   std::tie(serialized_msg, sequence_size) = pop_sequence_size(serialized_msg);
-  if (sequence_size > 0) {
-    auto sequence = reinterpret_cast<std::vector<bool> *>(ros_message_field);
-    debug_log("deserializing bool sequence of size %zu\n", sequence_size);
-    sequence->resize(sequence_size);
-    for (auto i = 0u; i < sequence_size; ++i) {
-      bool b{};
-      char * data = reinterpret_cast<char *>(&b);
-      serialized_msg = deserialize_element<bool>(serialized_msg, data);
-      sequence->at(i) = b;
-    }
+  auto sequence = reinterpret_cast<std::vector<bool> *>(ros_message_field);
+  debug_log("deserializing bool sequence of size %zu\n", sequence_size);
+  sequence->resize(sequence_size);
+  for (auto i = 0u; i < sequence_size; ++i) {
+    bool b{};
+    char * data = reinterpret_cast<char *>(&b);
+    serialized_msg = deserialize_element<bool>(serialized_msg, data);
+    sequence->at(i) = b;
   }
   return serialized_msg;
 }
 
-// error: cannot bind non-const lvalue reference of type ‘bool&’ to an rvalue of type ‘bool’
 template<>
 const char * deserialize_sequence<wchar_t, sizeof(wchar_t), std::wstring>(
   const char * serialized_msg, void * ros_message_field)
 {
   uint32_t sequence_size = 0;
   std::tie(serialized_msg, sequence_size) = pop_sequence_size(serialized_msg);
-  if (sequence_size > 0) {
-    debug_log("deserializing wstring sequence of size %zu\n", sequence_size);
-    auto sequence = reinterpret_cast<std::wstring *>(ros_message_field);
-    std::wstring str;
-    str.resize(sequence_size);
-    for (wchar_t & c : str) {
-      char * data = reinterpret_cast<char *>(&c);
-      serialized_msg = deserialize_element<wchar_t>(serialized_msg, data);
-    }
-    *sequence = str;
+  debug_log("deserializing wstring sequence of size %zu\n", sequence_size);
+  // empty strings have to be resized as well when a message is reused, resize keeps the capacity
+  auto sequence = reinterpret_cast<std::wstring *>(ros_message_field);
+  sequence->resize(sequence_size);
+  for (wchar_t & c : *sequence) {
+    char * data = reinterpret_cast<char *>(&c);
+    serialized_msg = deserialize_element<wchar_t>(serialized_msg, data);
   }
   return serialized_msg;
 }
@@ -309,6 +305,171 @@ const char * deserialize(
   return serialized_msg;
 }
 
+template<typename T>
+void reserve_sequence(void * ros_message_field, size_t capacity)
+{
+  reinterpret_cast<std::vector<T> *>(ros_message_field)->reserve(capacity);
+}
+
+void reserve_primitive_sequence(uint8_t type_id, void * ros_message_field, size_t capacity)
+{
+  switch (type_id) {
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
+      reserve_sequence<bool>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+      reserve_sequence<uint8_t>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+      reserve_sequence<int8_t>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+      reserve_sequence<float>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+      reserve_sequence<double>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+      reserve_sequence<int16_t>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+      reserve_sequence<uint16_t>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+      reserve_sequence<int32_t>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+      reserve_sequence<uint32_t>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+      reserve_sequence<int64_t>(ros_message_field, capacity);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+      reserve_sequence<uint64_t>(ros_message_field, capacity);
+      break;
+    default:
+      break;
+  }
+}
+
+void reserve_strings(std::string * strings, size_t count, size_t upper_bound)
+{
+  // std::string::reserve may shrink before C++20
+  for (size_t index = 0; index < count; ++index) {
+    if (strings[index].capacity() < upper_bound) {
+      strings[index].reserve(upper_bound);
+    }
+  }
+}
+
+/// @brief Appends the steps of a message type to the plan
+/// @return the range of the steps of the message in plan.steps
+std::pair<size_t, size_t> add_reserve_steps(
+  const rosidl_typesupport_introspection_cpp::MessageMembers * members,
+  ReservePlan & plan);
+
+/// @brief Collects the steps of the bounded fields, nested messages which are no sequences are
+/// flattened into the steps of the enclosing message
+void collect_reserve_steps(
+  const rosidl_typesupport_introspection_cpp::MessageMembers * members,
+  size_t base_offset,
+  std::vector<ReserveStep> & message_steps,
+  ReservePlan & plan)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    const size_t offset = base_offset + member->offset_;
+    const bool is_sequence = member->is_array_ &&
+      (member->array_size_ == 0 || member->is_upper_bound_);
+
+    if (member->type_id_ == ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE) {
+      auto sub_members =
+        static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+        member->members_->data);
+      if (!member->is_array_) {
+        collect_reserve_steps(sub_members, offset, message_steps, plan);
+      } else if (!is_sequence) {
+        for (size_t index = 0; index < member->array_size_; ++index) {
+          collect_reserve_steps(
+            sub_members, offset + index * sub_members->size_of_, message_steps, plan);
+        }
+      } else {
+        auto elements = add_reserve_steps(sub_members, plan);
+        if (member->is_upper_bound_ || elements.first != elements.second) {
+          message_steps.push_back({offset, member, elements.first, elements.second});
+        }
+      }
+    } else if (member->type_id_ == ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING) {
+      if (member->string_upper_bound_ > 0u || member->is_upper_bound_) {
+        message_steps.push_back({offset, member, 0u, 0u});
+      }
+    } else if (member->is_upper_bound_) {
+      message_steps.push_back({offset, member, 0u, 0u});
+    }
+  }
+}
+
+std::pair<size_t, size_t> add_reserve_steps(
+  const rosidl_typesupport_introspection_cpp::MessageMembers * members,
+  ReservePlan & plan)
+{
+  // the steps of sequence elements are appended while collecting, so the steps of the message
+  // are appended afterwards to keep them contiguous
+  std::vector<ReserveStep> message_steps;
+  collect_reserve_steps(members, 0u, message_steps, plan);
+  const size_t begin = plan.steps.size();
+  plan.steps.insert(plan.steps.end(), message_steps.begin(), message_steps.end());
+  return {begin, plan.steps.size()};
+}
+
+/// @brief Presizes the fields of the steps [begin, end) of a plan to their upper bounds
+/// Unbounded fields keep the capacity of the largest message taken. Elements which a take adds
+/// to a sequence are still allocated, std::vector destroys the elements beyond its size.
+void reserve(const ReservePlan & plan, size_t begin, size_t end, void * ros_message)
+{
+  for (size_t i = begin; i < end; ++i) {
+    const auto & step = plan.steps[i];
+    const auto * member =
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMember *>(step.member);
+    char * ros_message_field = static_cast<char *>(ros_message) + step.offset;
+
+    if (member->type_id_ == ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE) {
+      // only sequences of messages have steps of their own
+      auto sub_members =
+        static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+        member->members_->data);
+      // deserialize resizes sequences of messages through the same byte view, which can't
+      // relocate the elements, so only empty sequences are presized
+      auto sequence = reinterpret_cast<std::vector<unsigned char> *>(ros_message_field);
+      if (member->is_upper_bound_ && sequence->empty()) {
+        sequence->reserve(member->array_size_ * sub_members->size_of_);
+      }
+      for (size_t offset = 0; offset < sequence->size(); offset += sub_members->size_of_) {
+        reserve(plan, step.elements_begin, step.elements_end, sequence->data() + offset);
+      }
+    } else if (member->type_id_ == ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING) {
+      if (!member->is_array_) {
+        reserve_strings(
+          reinterpret_cast<std::string *>(ros_message_field), 1u, member->string_upper_bound_);
+      } else if (member->array_size_ > 0 && !member->is_upper_bound_) {
+        reserve_strings(
+          reinterpret_cast<std::string *>(ros_message_field), member->array_size_,
+          member->string_upper_bound_);
+      } else {
+        auto strings = reinterpret_cast<std::vector<std::string> *>(ros_message_field);
+        if (member->is_upper_bound_) {
+          strings->reserve(member->array_size_);
+        }
+        reserve_strings(strings->data(), strings->size(), member->string_upper_bound_);
+      }
+    } else {
+      reserve_primitive_sequence(member->type_id_, ros_message_field, member->array_size_);
+    }
+  }
+}
+
 }  // namespace details_cpp
 }  // namespace rmw_iceoryx_cpp
 #endif  // INTERNAL__ICEORYX_DESERIALIZE_TYPESUPPORT_CPP_HPP_
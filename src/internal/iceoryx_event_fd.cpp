@@ -0,0 +1,212 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#include "iceoryx_posh/popo/listener.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+#include "iceoryx_posh/popo/user_trigger.hpp"
+
+#include "rcutils/error_handling.h"
+
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+
+#include "rmw_iceoryx_cpp/iceoryx_event_fd.hpp"
+
+#include "../iceoryx_event_fd.hpp"
+#include "../iceoryx_listener_pool.hpp"
+#include "../types/iceoryx_subscription.hpp"
+#include "../types/iceoryx_wait_set.hpp"
+
+namespace details
+{
+struct EventFdAttachment
+{
+  int fd{-1};
+  iox::popo::Listener * listener{nullptr};
+};
+
+/// The event fds of the process, their listeners are the ones of the listener pool
+struct EventFdListeners
+{
+  std::mutex mutex_;
+  std::unordered_map<const void *, std::unique_ptr<EventFdAttachment>> attachments_;
+};
+
+EventFdListeners & event_fd_listeners()
+{
+  // never destroyed like the listener pool, the attachments refer to its listeners
+  static EventFdListeners * listeners = new EventFdListeners();
+  return *listeners;
+}
+
+void signal_event_fd(EventFdAttachment * attachment)
+{
+  eventfd_write(attachment->fd, 1u);
+}
+
+void on_data(iox::popo::UntypedSubscriber *, EventFdAttachment * attachment)
+{
+  signal_event_fd(attachment);
+}
+
+void on_trigger(iox::popo::UserTrigger *, EventFdAttachment * attachment)
+{
+  signal_event_fd(attachment);
+}
+
+template<typename AttachFunction>
+rmw_ret_t get_event_fd(const void * entity, AttachFunction attach, int * fd)
+{
+  auto & event_fd_listeners = details::event_fd_listeners();
+  std::lock_guard<std::mutex> lock(event_fd_listeners.mutex_);
+  auto it = event_fd_listeners.attachments_.find(entity);
+  if (it != event_fd_listeners.attachments_.end()) {
+    *fd = it->second->fd;
+    return RMW_RET_OK;
+  }
+
+  std::unique_ptr<EventFdAttachment> attachment(new (std::nothrow) EventFdAttachment());
+  if (!attachment) {
+    RMW_SET_ERROR_MSG("failed to allocate event fd attachment");
+    return RMW_RET_BAD_ALLOC;
+  }
+  attachment->fd = eventfd(0u, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (attachment->fd < 0) {
+    RMW_SET_ERROR_MSG("failed to create eventfd");
+    return RMW_RET_ERROR;
+  }
+
+  // iceoryx supports a single WaitSet or listener per entity, rmw_wait rejects the entity from
+  // now on
+  take_for_event_fd(entity);
+
+  attachment->listener = attach_to_listener_pool(
+    [&](iox::popo::Listener & listener) {
+      return attach(listener, *attachment);
+    });
+  if (!attachment->listener) {
+    RMW_SET_ERROR_MSG("failed to attach to event fd listener");
+    return_from_event_fd(entity);
+    close(attachment->fd);
+    return RMW_RET_ERROR;
+  }
+
+  *fd = attachment->fd;
+  event_fd_listeners.attachments_[entity] = std::move(attachment);
+  return RMW_RET_OK;
+}
+
+template<typename DetachFunction>
+void release_event_fd(const void * entity, DetachFunction detach)
+{
+  auto & event_fd_listeners = details::event_fd_listeners();
+  std::lock_guard<std::mutex> lock(event_fd_listeners.mutex_);
+  auto it = event_fd_listeners.attachments_.find(entity);
+  if (it == event_fd_listeners.attachments_.end()) {
+    return;
+  }
+  detach(*it->second->listener);
+  close(it->second->fd);
+  event_fd_listeners.attachments_.erase(it);
+  return_from_event_fd(entity);
+}
+}  // namespace details
+
+void release_event_fd(IceoryxSubscription * iceoryx_subscription)
+{
+  details::release_event_fd(
+    iceoryx_subscription, [iceoryx_subscription](iox::popo::Listener & listener) {
+      listener.detachEvent(
+        *iceoryx_subscription->iceoryx_receiver_, iox::popo::SubscriberEvent::DATA_RECEIVED);
+    });
+}
+
+void release_event_fd(iox::popo::UserTrigger * iceoryx_guard_condition)
+{
+  details::release_event_fd(
+    iceoryx_guard_condition, [iceoryx_guard_condition](iox::popo::Listener & listener) {
+      listener.detachEvent(*iceoryx_guard_condition);
+    });
+}
+
+namespace rmw_iceoryx_cpp
+{
+rmw_ret_t get_subscription_event_fd(const rmw_subscription_t * subscription, int * fd)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(fd, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    get_subscription_event_fd
+    : subscription, subscription->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_subscription = static_cast<IceoryxSubscription *>(subscription->data);
+  if (!iceoryx_subscription || !iceoryx_subscription->iceoryx_receiver_) {
+    RMW_SET_ERROR_MSG("subscription data is null");
+    return RMW_RET_ERROR;
+  }
+  auto & iceoryx_receiver = *iceoryx_subscription->iceoryx_receiver_;
+
+  return details::get_event_fd(
+    iceoryx_subscription,
+    [&iceoryx_receiver](iox::popo::Listener & listener, details::EventFdAttachment & attachment) {
+      if (listener.attachEvent(
+        iceoryx_receiver, iox::popo::SubscriberEvent::DATA_RECEIVED,
+        iox::popo::createNotificationCallback(details::on_data, attachment)).has_error())
+      {
+        return false;
+      }
+      // the listener only notifies about data which arrives from now on
+      if (iceoryx_receiver.hasData()) {
+        details::signal_event_fd(&attachment);
+      }
+      return true;
+    }, fd);
+}
+
+rmw_ret_t get_guard_condition_event_fd(const rmw_guard_condition_t * guard_condition, int * fd)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(guard_condition, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(fd, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    get_guard_condition_event_fd
+    : guard_condition, guard_condition->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_guard_condition = static_cast<iox::popo::UserTrigger *>(guard_condition->data);
+  if (!iceoryx_guard_condition) {
+    RMW_SET_ERROR_MSG("guard condition data is null");
+    return RMW_RET_ERROR;
+  }
+
+  return details::get_event_fd(
+    iceoryx_guard_condition,
+    [iceoryx_guard_condition](
+      iox::popo::Listener & listener, details::EventFdAttachment & attachment) {
+      return !listener.attachEvent(
+        *iceoryx_guard_condition,
+        iox::popo::createNotificationCallback(details::on_trigger, attachment)).has_error();
+    }, fd);
+}
+}  // namespace rmw_iceoryx_cpp
@@ -0,0 +1,201 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INTERNAL__ICEORYX_FLAT_LAYOUT_HPP_
+#define INTERNAL__ICEORYX_FLAT_LAYOUT_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "rosidl_runtime_c/primitives_sequence.h"
+#include "rosidl_runtime_c/string.h"
+
+#include "rosidl_typesupport_introspection_c/field_types.h"
+
+#include "./iceoryx_serialization_common.hpp"
+
+namespace rmw_iceoryx_cpp
+{
+namespace details_flat
+{
+
+/// Flat messages are C messages which are placed in a chunk, followed by the storage of all their
+/// bounded strings and sequences. When published, the data pointers of strings and sequences are
+/// replaced by their offset to the begin of the chunk since the chunk is mapped to different
+/// addresses in the subscribing processes.
+/// The layout of the C structs is computed from the introspection members in order to read flat
+/// messages with both, the C and the C++ type support.
+struct FlatSequence
+{
+  uintptr_t data;
+  size_t size;
+  size_t capacity;
+};
+static_assert(
+  sizeof(FlatSequence) == sizeof(rosidl_runtime_c__String) &&
+  sizeof(FlatSequence) == sizeof(rosidl_runtime_c__uint8__Sequence),
+  "strings and sequences of the C type support must have the same layout");
+
+constexpr size_t STORAGE_ALIGNMENT = 8u;
+
+inline size_t align_up(size_t value, size_t alignment)
+{
+  return (value + alignment - 1u) / alignment * alignment;
+}
+
+struct CLayout
+{
+  size_t size;
+  size_t alignment;
+};
+
+template<typename MembersT>
+CLayout struct_layout(const MembersT * members);
+
+template<typename MembersT, typename MemberT>
+CLayout element_layout(const MemberT * member)
+{
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+    return struct_layout(static_cast<const MembersT *>(member->members_->data));
+  }
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+    return {sizeof(FlatSequence), alignof(FlatSequence)};
+  }
+  size_t size = get_primitive_size(member->type_id_);
+  if (size == 0u) {
+    throw std::runtime_error(std::string("unsupported type in flat message: ") + member->name_);
+  }
+  return {size, size};
+}
+
+template<typename MembersT, typename MemberT>
+CLayout member_layout(const MemberT * member)
+{
+  if (!member->is_array_) {
+    return element_layout<MembersT>(member);
+  }
+  if (member->array_size_ > 0 && !member->is_upper_bound_) {
+    auto element = element_layout<MembersT>(member);
+    return {element.size * member->array_size_, element.alignment};
+  }
+  return {sizeof(FlatSequence), alignof(FlatSequence)};
+}
+
+/// @brief Calls f(member, offset) for every member with its offset in the C struct
+template<typename MembersT, typename F>
+CLayout for_each_member(const MembersT * members, F f)
+{
+  size_t offset = 0u;
+  size_t alignment = 1u;
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    auto layout = member_layout<MembersT>(member);
+    offset = align_up(offset, layout.alignment);
+    f(member, offset);
+    offset += layout.size;
+    alignment = std::max(alignment, layout.alignment);
+  }
+  return {align_up(offset, alignment), alignment};
+}
+
+template<typename MembersT>
+CLayout struct_layout(const MembersT * members)
+{
+  return for_each_member(members, [](auto, size_t) {});
+}
+
+/// @brief Whether all strings and sequences of a type, including nested ones, are bounded
+template<typename MembersT>
+bool is_bounded(const MembersT * members)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    if (member->is_array_ && member->array_size_ == 0) {
+      return false;
+    }
+    if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+      if (!is_bounded(static_cast<const MembersT *>(member->members_->data))) {
+        return false;
+      }
+    } else if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+      if (member->string_upper_bound_ == 0) {
+        return false;
+      }
+    } else if (get_primitive_size(member->type_id_) == 0u) {
+      // wide strings and long double
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief Size of the storage the bounded strings and sequences of a message need in the chunk
+template<typename MembersT>
+size_t storage_size(const MembersT * members);
+
+template<typename MembersT, typename MemberT>
+size_t element_storage_size(const MemberT * member)
+{
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+    return storage_size(static_cast<const MembersT *>(member->members_->data));
+  }
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+    return align_up(member->string_upper_bound_ + 1u, STORAGE_ALIGNMENT);
+  }
+  return 0u;
+}
+
+template<typename MembersT>
+size_t storage_size(const MembersT * members)
+{
+  size_t size = 0u;
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    size_t element_storage = element_storage_size<MembersT>(member);
+    if (!member->is_array_) {
+      size += element_storage;
+    } else if (!member->is_upper_bound_) {
+      size += member->array_size_ * element_storage;
+    } else {
+      auto element = element_layout<MembersT>(member);
+      size += align_up(member->array_size_ * element.size, STORAGE_ALIGNMENT);
+      size += member->array_size_ * element_storage;
+    }
+  }
+  return size;
+}
+
+template<typename MembersT>
+size_t flat_message_size(const MembersT * members)
+{
+  return align_up(struct_layout(members).size, STORAGE_ALIGNMENT) + storage_size(members);
+}
+
+/// @brief Resolves the offset of a relocated string or sequence and checks it against the chunk
+inline const char * resolve(
+  const char * chunk, size_t chunk_size, const FlatSequence * sequence, size_t element_size)
+{
+  if (sequence->size > sequence->capacity ||
+    sequence->data + sequence->size * element_size > chunk_size)
+  {
+    throw std::runtime_error("flat message exceeds chunk");
+  }
+  return chunk + sequence->data;
+}
+
+}  // namespace details_flat
+}  // namespace rmw_iceoryx_cpp
+#endif  // INTERNAL__ICEORYX_FLAT_LAYOUT_HPP_
@@ -0,0 +1,316 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "rcutils/allocator.h"
+
+#include "rosidl_runtime_c/string_functions.h"
+
+#include "rosidl_typesupport_introspection_c/field_types.h"
+#include "rosidl_typesupport_introspection_c/message_introspection.h"
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rmw_iceoryx_cpp/iceoryx_flat_message.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
+
+#include "./iceoryx_flat_layout.hpp"
+#include "./iceoryx_serialization_common.hpp"
+
+namespace rmw_iceoryx_cpp
+{
+namespace details_flat
+{
+
+using MembersC = rosidl_typesupport_introspection_c__MessageMembers;
+using MemberC = rosidl_typesupport_introspection_c__MessageMember;
+
+void init_members(const MembersC * members, char * message, char *& storage);
+
+/// @brief Moves the content of a string initialized by the C type support into the chunk
+void init_string(const MemberC * member, rosidl_runtime_c__String * string, char *& storage)
+{
+  size_t capacity = member->string_upper_bound_ + 1u;
+  char * data = storage;
+  storage += align_up(capacity, STORAGE_ALIGNMENT);
+
+  size_t size = 0u;
+  if (string->data) {
+    size = std::min(string->size, capacity - 1u);
+    memcpy(data, string->data, size);
+    rosidl_runtime_c__String__fini(string);
+  }
+  data[size] = '\0';
+  string->data = data;
+  string->size = size;
+  string->capacity = capacity;
+}
+
+void init_element(const MemberC * member, char * field, char *& storage)
+{
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+    init_members(static_cast<const MembersC *>(member->members_->data), field, storage);
+  } else if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+    init_string(member, reinterpret_cast<rosidl_runtime_c__String *>(field), storage);
+  }
+}
+
+/// @brief Moves the elements of a bounded sequence into the chunk
+/// The sequence structs of the C type support only differ in the type of the data pointer
+void init_sequence(const MemberC * member, char * field, char *& storage)
+{
+  auto sequence = reinterpret_cast<rosidl_runtime_c__uint8__Sequence *>(field);
+  const size_t capacity = member->array_size_;
+  const size_t element_size = element_layout<MembersC>(member).size;
+
+  char * elements = storage;
+  storage += align_up(capacity * element_size, STORAGE_ALIGNMENT);
+
+  // sequences might be initialized with default values
+  const size_t size = std::min(sequence->size, capacity);
+  if (sequence->data) {
+    memcpy(elements, sequence->data, size * element_size);
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    allocator.deallocate(sequence->data, allocator.state);
+  }
+  memset(elements + size * element_size, 0, (capacity - size) * element_size);
+
+  // elements which are not in use yet get their storage assigned as well
+  for (size_t i = 0; i < capacity; ++i) {
+    init_element(member, elements + i * element_size, storage);
+  }
+
+  sequence->data = reinterpret_cast<uint8_t *>(elements);
+  sequence->size = size;
+  sequence->capacity = capacity;
+}
+
+void init_members(const MembersC * members, char * message, char *& storage)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    char * field = message + member->offset_;
+    if (!member->is_array_) {
+      init_element(member, field, storage);
+    } else if (!member->is_upper_bound_) {
+      const size_t element_size = element_layout<MembersC>(member).size;
+      for (size_t index = 0; index < member->array_size_; ++index) {
+        init_element(member, field + index * element_size, storage);
+      }
+    } else {
+      init_sequence(member, field, storage);
+    }
+  }
+}
+
+void relocate_members(const MembersC * members, char * message, char * chunk, size_t chunk_size);
+
+uintptr_t to_offset(const void * data, const char * chunk, size_t chunk_size)
+{
+  auto address = static_cast<const char *>(data);
+  if (address < chunk || address >= chunk + chunk_size) {
+    throw std::runtime_error("data of flat message was reallocated outside of the chunk");
+  }
+  return static_cast<uintptr_t>(address - chunk);
+}
+
+void relocate_element(const MemberC * member, char * field, char * chunk, size_t chunk_size)
+{
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+    relocate_members(
+      static_cast<const MembersC *>(member->members_->data), field, chunk, chunk_size);
+  } else if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+    auto string = reinterpret_cast<rosidl_runtime_c__String *>(field);
+    auto flat = reinterpret_cast<FlatSequence *>(field);
+    flat->data = to_offset(string->data, chunk, chunk_size);
+  }
+}
+
+void relocate_members(const MembersC * members, char * message, char * chunk, size_t chunk_size)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    char * field = message + member->offset_;
+    const size_t element_size = element_layout<MembersC>(member).size;
+    if (!member->is_array_) {
+      relocate_element(member, field, chunk, chunk_size);
+    } else if (!member->is_upper_bound_) {
+      for (size_t index = 0; index < member->array_size_; ++index) {
+        relocate_element(member, field + index * element_size, chunk, chunk_size);
+      }
+    } else {
+      auto sequence = reinterpret_cast<rosidl_runtime_c__uint8__Sequence *>(field);
+      if (sequence->size > sequence->capacity || sequence->capacity > member->array_size_) {
+        throw std::runtime_error("sequence of flat message exceeds its upper bound");
+      }
+      char * elements = reinterpret_cast<char *>(sequence->data);
+      // the elements have to be relocated while their pointers are still valid
+      for (size_t index = 0; index < sequence->size; ++index) {
+        relocate_element(member, elements + index * element_size, chunk, chunk_size);
+      }
+      reinterpret_cast<FlatSequence *>(field)->data = to_offset(elements, chunk, chunk_size);
+    }
+  }
+}
+
+template<typename MembersT>
+void to_serialized(
+  const char * chunk,
+  size_t chunk_size,
+  const char * message,
+  const MembersT * members,
+  std::vector<char> & serialized_msg);
+
+template<typename MembersT, typename MemberT>
+void element_to_serialized(
+  const char * chunk,
+  size_t chunk_size,
+  const MemberT * member,
+  const char * field,
+  size_t element_size,
+  std::vector<char> & serialized_msg)
+{
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+    to_serialized(
+      chunk, chunk_size, field, static_cast<const MembersT *>(member->members_->data),
+      serialized_msg);
+  } else if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+    auto string = reinterpret_cast<const FlatSequence *>(field);
+    const char * data = resolve(chunk, chunk_size, string, sizeof(char));
+    push_sequence_size(serialized_msg, static_cast<uint32_t>(string->size));
+    serialized_msg.insert(serialized_msg.end(), data, data + string->size);
+  } else {
+    serialized_msg.insert(serialized_msg.end(), field, field + element_size);
+  }
+}
+
+template<typename MembersT>
+void to_serialized(
+  const char * chunk,
+  size_t chunk_size,
+  const char * message,
+  const MembersT * members,
+  std::vector<char> & serialized_msg)
+{
+  for_each_member(
+    members, [&](auto member, size_t offset) {
+      const char * field = message + offset;
+      const size_t element_size = element_layout<MembersT>(member).size;
+      if (!member->is_array_) {
+        element_to_serialized<MembersT>(
+          chunk, chunk_size, member, field, element_size, serialized_msg);
+      } else if (member->array_size_ > 0 && !member->is_upper_bound_) {
+        for (size_t index = 0; index < member->array_size_; ++index) {
+          element_to_serialized<MembersT>(
+            chunk, chunk_size, member, field + index * element_size, element_size, serialized_msg);
+        }
+      } else {
+        auto sequence = reinterpret_cast<const FlatSequence *>(field);
+        const char * elements = resolve(chunk, chunk_size, sequence, element_size);
+        push_sequence_size(serialized_msg, static_cast<uint32_t>(sequence->size));
+        for (size_t index = 0; index < sequence->size; ++index) {
+          element_to_serialized<MembersT>(
+            chunk, chunk_size, member, elements + index * element_size, element_size,
+            serialized_msg);
+        }
+      }
+    });
+}
+
+}  // namespace details_flat
+
+bool iceoryx_is_flat_type(const rosidl_message_type_support_t * type_supports)
+{
+  auto ts = get_type_support(type_supports);
+  if (ts.first != TypeSupportLanguage::C) {
+    return false;
+  }
+
+  auto members = static_cast<const details_flat::MembersC *>(ts.second->data);
+  if (!details_flat::is_bounded(members)) {
+    return false;
+  }
+  // the computed layout is used by the subscribers, so it has to match the generated struct
+  return details_flat::struct_layout(members).size == members->size_of_;
+}
+
+size_t iceoryx_get_flat_message_size(const rosidl_message_type_support_t * type_supports)
+{
+  auto ts = get_type_support(type_supports);
+  if (ts.first == TypeSupportLanguage::CPP) {
+    return details_flat::flat_message_size(
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data));
+  }
+  return details_flat::flat_message_size(
+    static_cast<const details_flat::MembersC *>(ts.second->data));
+}
+
+void iceoryx_init_flat_message(
+  const rosidl_message_type_support_t * type_supports,
+  void * chunk)
+{
+  auto ts = get_type_support(type_supports);
+  if (ts.first != TypeSupportLanguage::C) {
+    throw std::runtime_error("flat messages are only supported for the C type support");
+  }
+
+  auto members = static_cast<const details_flat::MembersC *>(ts.second->data);
+  members->init_function(chunk, ROSIDL_RUNTIME_C_MSG_INIT_ALL);
+
+  char * storage = static_cast<char *>(chunk) +
+    details_flat::align_up(members->size_of_, details_flat::STORAGE_ALIGNMENT);
+  details_flat::init_members(members, static_cast<char *>(chunk), storage);
+}
+
+void iceoryx_relocate_flat_message(
+  const rosidl_message_type_support_t * type_supports,
+  void * chunk)
+{
+  auto ts = get_type_support(type_supports);
+  if (ts.first != TypeSupportLanguage::C) {
+    throw std::runtime_error("flat messages are only supported for the C type support");
+  }
+
+  auto members = static_cast<const details_flat::MembersC *>(ts.second->data);
+  details_flat::relocate_members(
+    members, static_cast<char *>(chunk), static_cast<char *>(chunk),
+    details_flat::flat_message_size(members));
+}
+
+void iceoryx_flat_to_serialized(
+  const void * chunk,
+  size_t chunk_size,
+  const rosidl_message_type_support_t * type_supports,
+  std::vector<char> & serialized_msg)
+{
+  auto ts = get_type_support(type_supports);
+  auto flat_chunk = static_cast<const char *>(chunk);
+  if (ts.first == TypeSupportLanguage::CPP) {
+    details_flat::to_serialized(
+      flat_chunk, chunk_size, flat_chunk,
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data),
+      serialized_msg);
+  } else {
+    details_flat::to_serialized(
+      flat_chunk, chunk_size, flat_chunk,
+      static_cast<const details_flat::MembersC *>(ts.second->data),
+      serialized_msg);
+  }
+}
+
+}  // namespace rmw_iceoryx_cpp
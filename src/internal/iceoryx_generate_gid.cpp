@@ -13,6 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
+
 #include "rmw/rmw.h"
 #include "rmw/types.h"
 #include "rmw/impl/cpp/macros.hpp"
@@ -37,3 +39,16 @@ rmw_gid_t generate_publisher_gid(iox::popo::UntypedPublisher * const publisher)
 
   return gid;
 }
+
+rmw_gid_t generate_publisher_gid(uint64_t publisher_port_id)
+{
+  rmw_gid_t gid;
+  gid.implementation_identifier = rmw_get_implementation_identifier();
+  memset(gid.data, 0, RMW_GID_STORAGE_SIZE);
+
+  static_assert(
+    sizeof(publisher_port_id) <= RMW_GID_STORAGE_SIZE, "port id does not fit into the gid");
+  memcpy(gid.data, &publisher_port_id, sizeof(publisher_port_id));
+
+  return gid;
+}
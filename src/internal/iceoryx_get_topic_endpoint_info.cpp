@@ -17,82 +17,183 @@
 #include <vector>
 #include <tuple>
 
-#include "iceoryx_posh/popo/untyped_subscriber.hpp"
-#include "iceoryx_posh/roudi/introspection_types.hpp"
-
 #include "rcutils/logging_macros.h"
-#include "rcutils/strdup.h"
 
 #include "rmw/impl/cpp/macros.hpp"
+#include "rmw/qos_profiles.h"
 
-#include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
-#include "rmw_iceoryx_cpp/iceoryx_topic_names_and_types.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_get_topic_endpoint_info.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+
+#include "../iceoryx_generate_gid.hpp"
 
 namespace rmw_iceoryx_cpp
 {
-std::map<std::string, std::vector<std::string>> get_publisher_and_nodes()
+namespace details
+{
+std::map<std::string, std::vector<std::string>> get_topics_nodes(
+  const GraphCache::Graph & graph,
+  std::vector<GraphCache::Endpoint> GraphCache::Topic::* topic_endpoints)
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
+  std::map<std::string, std::vector<std::string>> topics_nodes;
+  for (const auto & topic : graph.topics) {
+    const auto & endpoints = topic.second.*topic_endpoints;
+    if (endpoints.empty()) {
+      continue;
+    }
+    auto & node_names = topics_nodes[graph.names.name(topic.first)];
+    for (const auto & endpoint : endpoints) {
+      node_names.push_back(graph.names.name(endpoint.node));
+    }
+  }
+  return topics_nodes;
+}
 
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
+std::tuple<std::string, std::vector<std::string>> get_end_info_of_topic(
+  const GraphCache::Graph & graph,
+  std::vector<GraphCache::Endpoint> GraphCache::Topic::* topic_endpoints,
+  const std::string & topic_name)
+{
+  std::vector<std::string> node_names;
+  auto topic = graph.find_topic(topic_name);
+  if (!topic) {
+    return std::make_tuple(std::string(), node_names);
+  }
+  node_names.reserve((topic->*topic_endpoints).size());
+  for (const auto & endpoint : topic->*topic_endpoints) {
+    node_names.push_back(graph.names.name(endpoint.node));
+  }
+  return std::make_tuple(graph.names.name(topic->type), node_names);
+}
 
-  return topic_publishers;
+/// @brief Sets the fields of one endpoint, the setters copy the strings
+rmw_ret_t set_end_info(
+  rmw_topic_endpoint_info_t * rmw_topic_endpoint_info,
+  const char * topic_type,
+  const char * node_name,
+  const char * node_namespace,
+  rmw_endpoint_type_t endpoint_type,
+  const rmw_gid_t & gid,
+  rcutils_allocator_t * allocator)
+{
+  rmw_ret_t rmw_ret =
+    rmw_topic_endpoint_info_set_topic_type(rmw_topic_endpoint_info, topic_type, allocator);
+  if (rmw_ret != RMW_RET_OK) {
+    return rmw_ret;
+  }
+  rmw_ret = rmw_topic_endpoint_info_set_node_name(rmw_topic_endpoint_info, node_name, allocator);
+  if (rmw_ret != RMW_RET_OK) {
+    return rmw_ret;
+  }
+  rmw_ret = rmw_topic_endpoint_info_set_node_namespace(
+    rmw_topic_endpoint_info, node_namespace, allocator);
+  if (rmw_ret != RMW_RET_OK) {
+    return rmw_ret;
+  }
+  rmw_ret = rmw_topic_endpoint_info_set_endpoint_type(rmw_topic_endpoint_info, endpoint_type);
+  if (rmw_ret != RMW_RET_OK) {
+    return rmw_ret;
+  }
+  rmw_ret = rmw_topic_endpoint_info_set_gid(
+    rmw_topic_endpoint_info, gid.data, RMW_GID_STORAGE_SIZE);
+  if (rmw_ret != RMW_RET_OK) {
+    return rmw_ret;
+  }
+  // the introspection does not report the history and queue capacities of the ports, so the
+  // profile of a remote endpoint is unknown
+  return rmw_topic_endpoint_info_set_qos_profile(
+    rmw_topic_endpoint_info, &rmw_qos_profile_unknown);
 }
 
-std::map<std::string, std::vector<std::string>> get_subscriber_and_nodes()
+/// @brief Allocates the array and fills each endpoint with set_endpoint(index, endpoint_info)
+template<typename SetEndpointT>
+rmw_ret_t fill_end_info(
+  rmw_topic_endpoint_info_array_t * rmw_topic_endpoint_info_array,
+  size_t count,
+  SetEndpointT set_endpoint,
+  rcutils_allocator_t * allocator)
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
+  if (count == 0u) {
+    return RMW_RET_OK;
+  }
+  rmw_ret_t rmw_ret = rmw_topic_endpoint_info_array_init_with_size(
+    rmw_topic_endpoint_info_array, count, allocator);
+  if (rmw_ret != RMW_RET_OK) {
+    return rmw_ret;
+  }
 
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
+  // store all data in rmw_topic_endpoint_info_array_t
+  for (size_t i = 0; i < count; ++i) {
+    auto & rmw_topic_endpoint_info = rmw_topic_endpoint_info_array->info_array[i];
+    rmw_topic_endpoint_info = rmw_get_zero_initialized_topic_endpoint_info();
+    if (set_endpoint(i, &rmw_topic_endpoint_info) != RMW_RET_OK) {
+      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
+      rmw_ret = rmw_topic_endpoint_info_array_fini(rmw_topic_endpoint_info_array, allocator);
+      if (rmw_ret != RMW_RET_OK) {
+        RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
+      }
+      return RMW_RET_ERROR;
+    }
+  }
+  return RMW_RET_OK;
+}
 
-  return topic_subscribers;
+rmw_ret_t fill_end_info_of_node_names(
+  rmw_topic_endpoint_info_array_t * rmw_topic_endpoint_info_array,
+  const std::tuple<std::string, std::vector<std::string>> & iceoryx_topic_endpoint_info,
+  rmw_endpoint_type_t endpoint_type,
+  rcutils_allocator_t * allocator)
+{
+  const auto & topic_type = std::get<0>(iceoryx_topic_endpoint_info);
+  const auto & full_name_array = std::get<1>(iceoryx_topic_endpoint_info);
+  // the node names only are known, the gids stay zero
+  rmw_gid_t gid{};
+
+  return fill_end_info(
+    rmw_topic_endpoint_info_array, full_name_array.size(),
+    [&](size_t i, rmw_topic_endpoint_info_t * rmw_topic_endpoint_info) {
+      auto name_n_space = get_name_n_space_from_node_full_name(full_name_array[i]);
+      return set_end_info(
+        rmw_topic_endpoint_info, topic_type.c_str(), std::get<0>(name_n_space).c_str(),
+        std::get<1>(name_n_space).c_str(), endpoint_type, gid, allocator);
+    },
+    allocator);
+}
+}  // namespace details
+
+std::map<std::string, std::vector<std::string>> get_publisher_and_nodes()
+{
+  return get_graph_cache().read(
+    [](const GraphCache::Graph & graph) {
+      return details::get_topics_nodes(graph, &GraphCache::Topic::publishers);
+    });
+}
+
+std::map<std::string, std::vector<std::string>> get_subscriber_and_nodes()
+{
+  return get_graph_cache().read(
+    [](const GraphCache::Graph & graph) {
+      return details::get_topics_nodes(graph, &GraphCache::Topic::subscribers);
+    });
 }
 
 std::tuple<std::string, std::vector<std::string>> get_publisher_end_info_of_topic(
   const char * topic_name)
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
-  auto full_name_array = topic_publishers[std::string(topic_name)];
-  auto topic_type = names_n_types[topic_name];
-  return std::make_tuple(topic_type, full_name_array);
+  return get_graph_cache().read(
+    [&](const GraphCache::Graph & graph) {
+      return details::get_end_info_of_topic(graph, &GraphCache::Topic::publishers, topic_name);
+    });
 }
 
 std::tuple<std::string, std::vector<std::string>> get_subscriber_end_info_of_topic(
   const char * topic_name)
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
-  auto full_name_array = topic_subscribers[std::string(topic_name)];
-  auto topic_type = names_n_types[topic_name];
-  return std::make_tuple(topic_type, full_name_array);
+  return get_graph_cache().read(
+    [&](const GraphCache::Graph & graph) {
+      return details::get_end_info_of_topic(graph, &GraphCache::Topic::subscribers, topic_name);
+    });
 }
 
 rmw_ret_t
@@ -101,85 +202,9 @@ fill_rmw_publisher_end_info(
   const std::tuple<std::string, std::vector<std::string>> & iceoryx_topic_endpoint_info,
   rcutils_allocator_t * allocator)
 {
-  rmw_ret_t rmw_ret = RMW_RET_ERROR;
-
-  auto topic_type = std::get<0>(iceoryx_topic_endpoint_info);
-  auto full_name_array = std::get<1>(iceoryx_topic_endpoint_info);
-
-  if (!full_name_array.empty()) {
-    rmw_ret = rmw_topic_endpoint_info_array_init_with_size(
-      rmw_topic_endpoint_info_array, full_name_array.size(),
-      allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      return rmw_ret;
-    }
-  }
-
-  int i = 0;
-  // store all data in rmw_topic_endpoint_info_array_t
-  for (const auto node_full_name : full_name_array) {
-    auto name_n_space = get_name_n_space_from_node_full_name(node_full_name);
-    auto rmw_topic_endpoint_info = rmw_get_zero_initialized_topic_endpoint_info();
-    // duplicate and store the topic_name
-    char * topic_type_cstr = rcutils_strdup(topic_type.c_str(), *allocator);
-    if (!topic_type_cstr) {
-      RMW_SET_ERROR_MSG("failed to allocate memory for topic_type");
-      goto fail;
-    }
-    rmw_ret = rmw_topic_endpoint_info_set_topic_type(
-      &rmw_topic_endpoint_info, topic_type_cstr,
-      allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-
-    char * node_name = rcutils_strdup(std::get<0>(name_n_space).c_str(), *allocator);
-    if (!node_name) {
-      RMW_SET_ERROR_MSG("failed to allocate memory for node_name");
-      goto fail;
-    }
-    rmw_ret = rmw_topic_endpoint_info_set_node_name(&rmw_topic_endpoint_info, node_name, allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-
-    char * node_namespace = rcutils_strdup(std::get<1>(name_n_space).c_str(), *allocator);
-    if (!node_namespace) {
-      RMW_SET_ERROR_MSG("failed to allocate memory for node_namespace");
-      goto fail;
-    }
-    rmw_ret = rmw_topic_endpoint_info_set_node_namespace(
-      &rmw_topic_endpoint_info, node_namespace,
-      allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-
-    rmw_ret = rmw_topic_endpoint_info_set_endpoint_type(
-      &rmw_topic_endpoint_info,
-      RMW_ENDPOINT_PUBLISHER);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-    /// @todo support gid and qos setting
-
-    // set array
-    rmw_topic_endpoint_info_array->info_array[i] = rmw_topic_endpoint_info;
-    i++;
-  }
-
-  return RMW_RET_OK;
-
-fail:
-  rmw_ret = rmw_topic_endpoint_info_array_fini(rmw_topic_endpoint_info_array, allocator);
-  if (rmw_ret != RMW_RET_OK) {
-    RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-  }
-  return RMW_RET_ERROR;
+  return details::fill_end_info_of_node_names(
+    rmw_topic_endpoint_info_array, iceoryx_topic_endpoint_info, RMW_ENDPOINT_PUBLISHER,
+    allocator);
 }
 
 rmw_ret_t
@@ -188,85 +213,45 @@ fill_rmw_subscriber_end_info(
   const std::tuple<std::string, std::vector<std::string>> & iceoryx_topic_endpoint_info,
   rcutils_allocator_t * allocator)
 {
-  rmw_ret_t rmw_ret = RMW_RET_ERROR;
-
-  auto topic_type = std::get<0>(iceoryx_topic_endpoint_info);
-  auto full_name_array = std::get<1>(iceoryx_topic_endpoint_info);
-
-  if (!full_name_array.empty()) {
-    rmw_ret = rmw_topic_endpoint_info_array_init_with_size(
-      rmw_topic_endpoint_info_array, full_name_array.size(),
-      allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      return rmw_ret;
-    }
-  }
-
-  int i = 0;
-  // store all data in rmw_topic_endpoint_info_array_t
-  for (const auto node_full_name : full_name_array) {
-    auto name_n_space = get_name_n_space_from_node_full_name(node_full_name);
-    auto rmw_topic_endpoint_info = rmw_get_zero_initialized_topic_endpoint_info();
-    // duplicate and store the topic_name
-    char * topic_type_cstr = rcutils_strdup(topic_type.c_str(), *allocator);
-    if (!topic_type_cstr) {
-      RMW_SET_ERROR_MSG("failed to allocate memory for topic_type");
-      goto fail;
-    }
-    rmw_ret = rmw_topic_endpoint_info_set_topic_type(
-      &rmw_topic_endpoint_info, topic_type_cstr,
-      allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-
-    char * node_name = rcutils_strdup(std::get<0>(name_n_space).c_str(), *allocator);
-    if (!node_name) {
-      RMW_SET_ERROR_MSG("failed to allocate memory for node_name");
-      goto fail;
-    }
-    rmw_ret = rmw_topic_endpoint_info_set_node_name(&rmw_topic_endpoint_info, node_name, allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-
-    char * node_namespace = rcutils_strdup(std::get<1>(name_n_space).c_str(), *allocator);
-    if (!node_namespace) {
-      RMW_SET_ERROR_MSG("failed to allocate memory for node_namespace");
-      goto fail;
-    }
-    rmw_ret = rmw_topic_endpoint_info_set_node_namespace(
-      &rmw_topic_endpoint_info, node_namespace,
-      allocator);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-
-    rmw_ret = rmw_topic_endpoint_info_set_endpoint_type(
-      &rmw_topic_endpoint_info,
-      RMW_ENDPOINT_SUBSCRIPTION);
-    if (rmw_ret != RMW_RET_OK) {
-      RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
-      goto fail;
-    }
-    /// @todo support gid and qos setting
-
-    // set array
-    rmw_topic_endpoint_info_array->info_array[i] = rmw_topic_endpoint_info;
-    i++;
-  }
-
-  return RMW_RET_OK;
+  return details::fill_end_info_of_node_names(
+    rmw_topic_endpoint_info_array, iceoryx_topic_endpoint_info, RMW_ENDPOINT_SUBSCRIPTION,
+    allocator);
+}
 
-fail:
-  rmw_ret = rmw_topic_endpoint_info_array_fini(rmw_topic_endpoint_info_array, allocator);
-  if (rmw_ret != RMW_RET_OK) {
-    RCUTILS_LOG_ERROR("error during report of error: %s", rmw_get_error_string().str);
+rmw_ret_t
+fill_rmw_end_info(
+  rmw_topic_endpoint_info_array_t * rmw_topic_endpoint_info_array,
+  const GraphCache::Graph & graph,
+  const char * topic_name,
+  rmw_endpoint_type_t endpoint_type,
+  rcutils_allocator_t * allocator)
+{
+  auto topic = graph.find_topic(topic_name);
+  if (!topic) {
+    return RMW_RET_OK;
   }
-  return RMW_RET_ERROR;
+  const auto & endpoints =
+    (endpoint_type == RMW_ENDPOINT_PUBLISHER) ? topic->publishers : topic->subscribers;
+  const char * topic_type = graph.names.name(topic->type).c_str();
+
+  return details::fill_end_info(
+    rmw_topic_endpoint_info_array, endpoints.size(),
+    [&](size_t i, rmw_topic_endpoint_info_t * rmw_topic_endpoint_info) {
+      const auto & endpoint = endpoints[i];
+      auto node = graph.nodes.find(endpoint.node);
+      if (node == graph.nodes.end()) {
+        RMW_SET_ERROR_MSG("endpoint of unknown node");
+        return RMW_RET_ERROR;
+      }
+      rmw_gid_t gid{};
+      if (endpoint_type == RMW_ENDPOINT_PUBLISHER) {
+        gid = generate_publisher_gid(endpoint.port_id);
+      }
+      return details::set_end_info(
+        rmw_topic_endpoint_info, topic_type, graph.names.name(node->second.name).c_str(),
+        graph.names.name(node->second.namespace_).c_str(), endpoint_type, gid, allocator);
+    },
+    allocator);
 }
 
 }  // namespace rmw_iceoryx_cpp
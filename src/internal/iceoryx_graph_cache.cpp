@@ -0,0 +1,559 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "iceoryx_posh/roudi/introspection_types.hpp"
+
+#include "rcutils/logging_macros.h"
+
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+
+namespace rmw_iceoryx_cpp
+{
+
+constexpr NameTable::Id NameTable::INVALID_ID;
+constexpr size_t GraphCache::DELTA_HISTORY_SIZE;
+
+size_t NameTable::NameRefHash::operator()(const NameRef & name) const
+{
+  // FNV-1a, the names are hashed without copying them into a std::string
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < name.size; ++i) {
+    hash ^= static_cast<unsigned char>(name.data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
+
+NameTable::Id NameTable::intern(const char * name)
+{
+  auto known = ids_.find(NameRef{name, std::strlen(name)});
+  if (known != ids_.end()) {
+    return known->second;
+  }
+  auto id = static_cast<Id>(names_.size());
+  names_.emplace_back(name);
+  ids_.emplace(NameRef{names_.back().data(), names_.back().size()}, id);
+  return id;
+}
+
+NameTable::Id NameTable::find(const char * name) const
+{
+  auto known = ids_.find(NameRef{name, std::strlen(name)});
+  return (known == ids_.end()) ? INVALID_ID : known->second;
+}
+
+namespace details
+{
+inline uint64_t get_port_id(const iox::roudi::PublisherPortData & port)
+{
+  return port.m_publisherPortID;
+}
+
+inline uint64_t get_port_id(const iox::roudi::SubscriberPortData &)
+{
+  return 0u;
+}
+
+template<typename PortDataListT>
+GraphCache::Port make_port(NameTable & names, const PortDataListT & port)
+{
+  return GraphCache::Port{
+    names.intern(port.m_node.c_str()),
+    names.intern(port.m_caproServiceID.c_str()),
+    names.intern(port.m_caproInstanceID.c_str()),
+    names.intern(port.m_caproEventMethodID.c_str()),
+    get_port_id(port)};
+}
+
+/// @param[out] service_ports the ports of the request and response topics, which are not part
+/// of the topic graph
+template<typename PortDataListT>
+GraphCache::PortCounts count_ports(
+  NameTable & names,
+  const PortDataListT & port_list,
+  GraphCache::PortCounts & service_ports)
+{
+  GraphCache::PortCounts ports;
+  ports.reserve(port_list.size());
+  for (auto & port : port_list) {
+    if (is_service_instance(port.m_caproInstanceID.c_str())) {
+      ++service_ports[make_port(names, port)];
+    } else {
+      ++ports[make_port(names, port)];
+    }
+  }
+  return ports;
+}
+
+/// @brief Rebuilds the services from the ports of the request and response topics
+void update_services(GraphCache::Graph & graph, const GraphCache::PortCounts & service_ports)
+{
+  graph.services.clear();
+  for (auto & port : service_ports) {
+    auto name_and_type = get_service_name_n_type_from_request_description(
+      graph.names.name(port.first.service), graph.names.name(port.first.instance));
+    if (!std::get<0>(name_and_type).empty()) {
+      graph.services[graph.names.intern(std::get<0>(name_and_type))] =
+        graph.names.intern(std::get<1>(name_and_type));
+    }
+  }
+}
+
+/// @brief The endpoint lists of the ports of one kind
+struct Endpoints
+{
+  std::vector<GraphCache::Endpoint> GraphCache::Topic::* topic_endpoints;
+  std::vector<GraphCache::Id> GraphCache::Node::* node_topics;
+  GraphCache::GraphChange::Kind added;
+  GraphCache::GraphChange::Kind removed;
+};
+
+using Change = GraphCache::GraphChange;
+
+/// @brief Removes one element for which matches returns true, the order is irrelevant
+template<typename T, typename MatchT>
+void erase_one(std::vector<T> & values, MatchT matches)
+{
+  auto it = std::find_if(values.begin(), values.end(), matches);
+  if (it != values.end()) {
+    *it = values.back();
+    values.pop_back();
+  }
+}
+
+GraphCache::Node & get_node(GraphCache::Graph & graph, GraphCache::Id node)
+{
+  auto graph_node = graph.nodes.find(node);
+  if (graph_node != graph.nodes.end()) {
+    return graph_node->second;
+  }
+  auto & new_node = graph.nodes[node];
+  auto name_n_space = get_name_n_space_from_node_full_name(graph.names.name(node));
+  new_node.name = graph.names.intern(std::get<0>(name_n_space));
+  new_node.namespace_ = graph.names.intern(std::get<1>(name_n_space));
+  return new_node;
+}
+
+void add_endpoint(
+  GraphCache::Graph & graph,
+  Endpoints endpoints,
+  const GraphCache::Port & port,
+  GraphCache::Id topic,
+  GraphCache::Id type,
+  GraphCache::GraphDelta & delta)
+{
+  if (graph.nodes.find(port.node) == graph.nodes.end()) {
+    delta.changes.push_back(Change{Change::Kind::NODE_APPEARED, port.node, NameTable::INVALID_ID});
+    delta.affects_all_nodes = true;
+  }
+  auto & graph_topic = graph.topics[topic];
+  graph_topic.type = type;
+  (graph_topic.*endpoints.topic_endpoints).push_back(GraphCache::Endpoint{port.node, port.port_id});
+  (get_node(graph, port.node).*endpoints.node_topics).push_back(topic);
+  delta.changes.push_back(Change{endpoints.added, port.node, topic});
+}
+
+void remove_endpoint(
+  GraphCache::Graph & graph,
+  Endpoints endpoints,
+  const GraphCache::Port & port,
+  GraphCache::Id topic,
+  GraphCache::GraphDelta & delta)
+{
+  delta.changes.push_back(Change{endpoints.removed, port.node, topic});
+
+  auto graph_topic = graph.topics.find(topic);
+  if (graph_topic != graph.topics.end()) {
+    erase_one(
+      graph_topic->second.*endpoints.topic_endpoints,
+      [&port](const GraphCache::Endpoint & endpoint) {
+        return endpoint.node == port.node && endpoint.port_id == port.port_id;
+      });
+    if (graph_topic->second.publishers.empty() && graph_topic->second.subscribers.empty()) {
+      graph.topics.erase(graph_topic);
+    }
+  }
+  auto graph_node = graph.nodes.find(port.node);
+  if (graph_node != graph.nodes.end()) {
+    erase_one(
+      graph_node->second.*endpoints.node_topics,
+      [topic](GraphCache::Id node_topic) {return node_topic == topic;});
+    if (graph_node->second.publishers.empty() && graph_node->second.subscribers.empty()) {
+      graph.nodes.erase(graph_node);
+      delta.changes.push_back(
+        Change{Change::Kind::NODE_VANISHED, port.node, NameTable::INVALID_ID});
+      delta.affects_all_nodes = true;
+    }
+  }
+}
+
+/// @return the interned topic name and type of a port
+std::pair<GraphCache::Id, GraphCache::Id> get_topic_and_type(
+  NameTable & names,
+  const GraphCache::Port & port)
+{
+  auto name_and_type = get_name_n_type_from_service_description(
+    names.name(port.service), names.name(port.instance), names.name(port.event));
+  return std::make_pair(
+    names.intern(std::get<0>(name_and_type)), names.intern(std::get<1>(name_and_type)));
+}
+
+/// @brief Applies the difference between the ports of two samples to the graph
+void apply_port_changes(
+  GraphCache::Graph & graph,
+  Endpoints endpoints,
+  const GraphCache::PortCounts & old_ports,
+  const GraphCache::PortCounts & new_ports,
+  GraphCache::GraphDelta & delta)
+{
+  for (auto & old_port : old_ports) {
+    auto new_port = new_ports.find(old_port.first);
+    size_t new_count = (new_port == new_ports.end()) ? 0u : new_port->second;
+    if (new_count >= old_port.second) {
+      continue;
+    }
+    auto topic_and_type = get_topic_and_type(graph.names, old_port.first);
+    for (size_t i = new_count; i < old_port.second; ++i) {
+      remove_endpoint(graph, endpoints, old_port.first, topic_and_type.first, delta);
+    }
+  }
+  for (auto & new_port : new_ports) {
+    auto old_port = old_ports.find(new_port.first);
+    size_t old_count = (old_port == old_ports.end()) ? 0u : old_port->second;
+    if (old_count >= new_port.second) {
+      continue;
+    }
+    auto topic_and_type = get_topic_and_type(graph.names, new_port.first);
+    for (size_t i = old_count; i < new_port.second; ++i) {
+      add_endpoint(
+        graph, endpoints, new_port.first, topic_and_type.first, topic_and_type.second, delta);
+    }
+  }
+}
+
+/// enclave of all nodes, see GraphCache::NodeName
+constexpr const char DEFAULT_ENCLAVE[] = "/";
+
+/// @brief Rebuilds the node names, the nodes which are known already are not split again
+void update_node_names(GraphCache::Graph & graph, const std::vector<GraphCache::Id> & node_ids)
+{
+  std::unordered_map<GraphCache::Id, GraphCache::NodeName> known_nodes;
+  known_nodes.reserve(graph.node_names.size());
+  for (auto & node_name : graph.node_names) {
+    known_nodes.emplace(node_name.full_name, node_name);
+  }
+
+  std::vector<GraphCache::NodeName> node_names;
+  node_names.reserve(node_ids.size());
+  for (auto node_id : node_ids) {
+    auto known_node = known_nodes.find(node_id);
+    if (known_node != known_nodes.end()) {
+      node_names.push_back(known_node->second);
+      continue;
+    }
+    auto name_n_space = get_name_n_space_from_node_full_name(graph.names.name(node_id));
+    node_names.push_back(
+      GraphCache::NodeName{node_id, graph.names.intern(std::get<0>(name_n_space)),
+        graph.names.intern(std::get<1>(name_n_space)), graph.names.intern(DEFAULT_ENCLAVE)});
+  }
+
+  std::sort(
+    node_names.begin(), node_names.end(),
+    [&graph](const GraphCache::NodeName & lhs, const GraphCache::NodeName & rhs) {
+      return graph.names.name(lhs.full_name) < graph.names.name(rhs.full_name);
+    });
+  graph.node_names = std::move(node_names);
+}
+
+/// @brief Adds a change for each node which is only in one of the sorted node lists
+void add_node_changes(
+  const std::vector<GraphCache::Id> & old_nodes,
+  const std::vector<GraphCache::Id> & new_nodes,
+  GraphCache::GraphDelta & delta)
+{
+  std::vector<GraphCache::Id> nodes;
+  std::set_difference(
+    new_nodes.begin(), new_nodes.end(), old_nodes.begin(), old_nodes.end(),
+    std::back_inserter(nodes));
+  for (auto node : nodes) {
+    delta.changes.push_back(Change{Change::Kind::NODE_APPEARED, node, NameTable::INVALID_ID});
+  }
+  nodes.clear();
+  std::set_difference(
+    old_nodes.begin(), old_nodes.end(), new_nodes.begin(), new_nodes.end(),
+    std::back_inserter(nodes));
+  for (auto node : nodes) {
+    delta.changes.push_back(Change{Change::Kind::NODE_VANISHED, node, NameTable::INVALID_ID});
+  }
+}
+
+/// @brief The nodes of the changes and the nodes with endpoints on the changed topics
+/// Only the topics of the delta are visited, not the whole graph
+void collect_affected_nodes(const GraphCache::Graph & graph, GraphCache::GraphDelta & delta)
+{
+  std::vector<GraphCache::Id> topics;
+  for (auto & change : delta.changes) {
+    delta.affected_nodes.push_back(change.node);
+    if (change.topic != NameTable::INVALID_ID) {
+      topics.push_back(change.topic);
+    }
+  }
+  std::sort(topics.begin(), topics.end());
+  topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+  for (auto topic : topics) {
+    auto graph_topic = graph.topics.find(topic);
+    if (graph_topic == graph.topics.end()) {
+      continue;
+    }
+    for (auto & endpoint : graph_topic->second.publishers) {
+      delta.affected_nodes.push_back(endpoint.node);
+    }
+    for (auto & endpoint : graph_topic->second.subscribers) {
+      delta.affected_nodes.push_back(endpoint.node);
+    }
+  }
+  std::sort(delta.affected_nodes.begin(), delta.affected_nodes.end());
+  delta.affected_nodes.erase(
+    std::unique(delta.affected_nodes.begin(), delta.affected_nodes.end()),
+    delta.affected_nodes.end());
+}
+
+size_t count_endpoints(
+  const GraphCache::Graph & graph,
+  const std::string & topic_name,
+  std::vector<GraphCache::Endpoint> GraphCache::Topic::* topic_endpoints)
+{
+  auto topic = graph.find_topic(topic_name);
+  return topic ? (topic->*topic_endpoints).size() : 0u;
+}
+}  // namespace details
+
+size_t GraphCache::PortHash::operator()(const Port & port) const
+{
+  size_t seed = port.node;
+  for (uint64_t part : {static_cast<uint64_t>(port.service), static_cast<uint64_t>(port.instance),
+      static_cast<uint64_t>(port.event), port.port_id})
+  {
+    seed ^= static_cast<size_t>(part) + 0x9e3779b9u + (seed << 6u) + (seed >> 2u);
+  }
+  return seed;
+}
+
+GraphCache::GraphDelta GraphCache::update(
+  const iox::roudi::PortIntrospectionFieldTopic & port_sample)
+{
+  GraphDelta delta;
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the sample is a full snapshot, only its difference to the last one is applied to the graph
+  PortCounts service_ports;
+  auto publisher_ports =
+    details::count_ports(graph_.names, port_sample.m_publisherList, service_ports);
+  auto subscriber_ports =
+    details::count_ports(graph_.names, port_sample.m_subscriberList, service_ports);
+  if (service_ports != service_ports_) {
+    details::update_services(graph_, service_ports);
+    service_ports_ = std::move(service_ports);
+  }
+
+  details::apply_port_changes(
+    graph_, details::Endpoints{&Topic::publishers, &Node::publishers,
+      GraphChange::Kind::PUBLISHER_ADDED, GraphChange::Kind::PUBLISHER_REMOVED},
+    publisher_ports_, publisher_ports, delta);
+  details::apply_port_changes(
+    graph_, details::Endpoints{&Topic::subscribers, &Node::subscribers,
+      GraphChange::Kind::SUBSCRIBER_ADDED, GraphChange::Kind::SUBSCRIBER_REMOVED},
+    subscriber_ports_, subscriber_ports, delta);
+  publisher_ports_ = std::move(publisher_ports);
+  subscriber_ports_ = std::move(subscriber_ports);
+  details::collect_affected_nodes(graph_, delta);
+  record_delta(delta);
+  has_ports_ = true;
+  if (has_processes_) {
+    is_ready_.store(true, std::memory_order_release);
+    ready_condition_.notify_all();
+  }
+  return delta;
+}
+
+GraphCache::GraphDelta GraphCache::update(
+  const iox::roudi::ProcessIntrospectionFieldTopic & process_sample)
+{
+  GraphDelta delta;
+  std::lock_guard<std::mutex> lock(mutex_);
+  // interning the names of known nodes does not allocate
+  std::vector<Id> process_nodes;
+  for (auto & process : process_sample.m_processList) {
+    for (auto & runnable : process.m_nodes) {
+      process_nodes.push_back(graph_.names.intern(runnable.c_str()));
+    }
+  }
+  std::sort(process_nodes.begin(), process_nodes.end());
+  process_nodes.erase(std::unique(process_nodes.begin(), process_nodes.end()), process_nodes.end());
+
+  if (process_nodes != process_nodes_) {
+    details::update_node_names(graph_, process_nodes);
+    details::add_node_changes(process_nodes_, process_nodes, delta);
+    delta.affects_all_nodes = true;
+    process_nodes_ = std::move(process_nodes);
+  }
+  record_delta(delta);
+  has_processes_ = true;
+  if (has_ports_) {
+    is_ready_.store(true, std::memory_order_release);
+    ready_condition_.notify_all();
+  }
+  return delta;
+}
+
+bool GraphCache::changes_since(uint64_t generation, std::vector<GraphChange> & changes) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (generation < dropped_generation_) {
+    return false;
+  }
+  for (auto & delta : history_) {
+    if (delta.generation > generation) {
+      changes.insert(changes.end(), delta.changes.begin(), delta.changes.end());
+    }
+  }
+  return true;
+}
+
+bool GraphCache::delta_since(uint64_t generation, GraphDelta & delta) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  delta.generation = generation_.load(std::memory_order_acquire);
+  if (generation < dropped_generation_) {
+    delta.affects_all_nodes = true;
+    return false;
+  }
+  for (auto & recorded : history_) {
+    if (recorded.generation <= generation) {
+      continue;
+    }
+    delta.changes.insert(delta.changes.end(), recorded.changes.begin(), recorded.changes.end());
+    delta.affected_nodes.insert(
+      delta.affected_nodes.end(), recorded.affected_nodes.begin(), recorded.affected_nodes.end());
+    delta.affects_all_nodes |= recorded.affects_all_nodes;
+  }
+  std::sort(delta.affected_nodes.begin(), delta.affected_nodes.end());
+  delta.affected_nodes.erase(
+    std::unique(delta.affected_nodes.begin(), delta.affected_nodes.end()),
+    delta.affected_nodes.end());
+  return true;
+}
+
+GraphCache::Id GraphCache::intern(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return graph_.names.intern(name);
+}
+
+void GraphCache::record_delta(GraphDelta & delta)
+{
+  delta.generation = generation_.fetch_add(1u, std::memory_order_acq_rel) + 1u;
+  if (delta.empty()) {
+    return;
+  }
+  if (history_.size() == DELTA_HISTORY_SIZE) {
+    dropped_generation_ = history_.front().generation;
+    history_.pop_front();
+  }
+  history_.push_back(delta);
+}
+
+bool GraphCache::wait_until_ready(std::chrono::nanoseconds timeout) const
+{
+  if (is_ready_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  return ready_condition_.wait_for(
+    lock, timeout, [this] {return is_ready_.load(std::memory_order_acquire);});
+}
+
+size_t GraphCache::count_publishers(const std::string & topic_name) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return details::count_endpoints(graph_, topic_name, &Topic::publishers);
+}
+
+size_t GraphCache::count_subscribers(const std::string & topic_name) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return details::count_endpoints(graph_, topic_name, &Topic::subscribers);
+}
+
+namespace details
+{
+/// queries proceed with an incomplete graph if the introspection does not deliver within this time
+constexpr std::chrono::seconds FIRST_SAMPLE_TIMEOUT{5};
+/// only the first query of the process waits for the introspection, the timeout is latched
+std::once_flag first_sample_wait;
+
+GraphCache & process_graph_cache()
+{
+  static GraphCache graph_cache;
+  return graph_cache;
+}
+}  // namespace details
+
+const GraphCache & get_graph_cache()
+{
+  auto & graph_cache = details::process_graph_cache();
+  std::call_once(
+    details::first_sample_wait, [&graph_cache] {
+      if (!graph_cache.wait_until_ready(details::FIRST_SAMPLE_TIMEOUT)) {
+        RCUTILS_LOG_WARN_NAMED(
+          "rmw_iceoryx_cpp",
+          "no introspection sample received yet, the graph is incomplete until it arrives");
+      }
+    });
+  return graph_cache;
+}
+
+/// @todo Use the new service discovery API of iceoryx v2.0 here instead of introspection topics
+void update_graph_cache(const iox::roudi::PortIntrospectionFieldTopic & port_sample)
+{
+  details::process_graph_cache().update(port_sample);
+}
+
+void update_graph_cache(const iox::roudi::ProcessIntrospectionFieldTopic & process_sample)
+{
+  details::process_graph_cache().update(process_sample);
+}
+
+bool graph_delta_since(uint64_t generation, GraphCache::GraphDelta & delta)
+{
+  return details::process_graph_cache().delta_since(generation, delta);
+}
+
+GraphCache::Id intern_graph_name(const std::string & name)
+{
+  return details::process_graph_cache().intern(name);
+}
+
+}  // namespace rmw_iceoryx_cpp
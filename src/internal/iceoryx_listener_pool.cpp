@@ -0,0 +1,59 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "iceoryx_posh/popo/listener.hpp"
+
+#include "../iceoryx_listener_pool.hpp"
+
+namespace details
+{
+struct ListenerPool
+{
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<iox::popo::Listener>> listeners_;
+};
+
+ListenerPool & listener_pool()
+{
+  // never destroyed, destroying the listeners at exit would race with the shutdown of the
+  // iceoryx runtime
+  static ListenerPool * pool = new ListenerPool();
+  return *pool;
+}
+}  // namespace details
+
+iox::popo::Listener * attach_to_listener_pool(
+  const std::function<bool(iox::popo::Listener &)> & attach)
+{
+  auto & pool = details::listener_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex_);
+  for (auto & listener : pool.listeners_) {
+    if (attach(*listener)) {
+      return listener.get();
+    }
+  }
+
+  std::unique_ptr<iox::popo::Listener> listener(new (std::nothrow) iox::popo::Listener());
+  if (!listener || !attach(*listener)) {
+    return nullptr;
+  }
+  pool.listeners_.push_back(std::move(listener));
+  return pool.listeners_.back().get();
+}
@@ -0,0 +1,294 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "rosidl_typesupport_introspection_c/field_types.h"
+#include "rosidl_typesupport_introspection_c/message_introspection.h"
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rmw_iceoryx_cpp/iceoryx_message_view.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
+
+#include "./iceoryx_flat_layout.hpp"
+#include "./iceoryx_serialization_common.hpp"
+
+namespace rmw_iceoryx_cpp
+{
+namespace details
+{
+
+template<typename MembersT>
+const char * index_serialized(
+  const char * serialized_msg,
+  const MembersT * members,
+  std::vector<MessageView::Field> * fields);
+
+template<typename MemberT>
+const char * skip_string(const char * serialized_msg, const MemberT * member)
+{
+  uint32_t string_size = 0;
+  std::tie(serialized_msg, string_size) = pop_sequence_size(serialized_msg);
+  return serialized_msg + string_size * get_character_size(member->type_id_);
+}
+
+/// @brief Walks over a field of the serialized format as written by rmw_iceoryx_cpp::serialize
+/// @return pointer behind the field
+template<typename MembersT, typename MemberT>
+const char * index_serialized_field(
+  const char * serialized_msg,
+  const MemberT * member,
+  MessageView::Field & field)
+{
+  field.name = member->name_;
+  field.type_id = member->type_id_;
+  field.is_array = member->is_array_;
+
+  size_t count = 1u;
+  if (member->is_array_) {
+    if (member->array_size_ > 0 && !member->is_upper_bound_) {
+      count = member->array_size_;
+    } else {
+      uint32_t sequence_size = 0;
+      std::tie(serialized_msg, sequence_size) = pop_sequence_size(serialized_msg);
+      count = sequence_size;
+    }
+  }
+
+  if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+    auto sub_members = static_cast<const MembersT *>(member->members_->data);
+    field.sub_members = sub_members;
+    field.data = serialized_msg;
+    field.size = count;
+    for (size_t i = 0; i < count; ++i) {
+      serialized_msg = index_serialized<MembersT>(serialized_msg, sub_members, nullptr);
+    }
+  } else if (is_string_type(member->type_id_)) {
+    if (!member->is_array_) {
+      // a single string is exposed as array of characters
+      uint32_t string_size = 0;
+      std::tie(serialized_msg, string_size) = pop_sequence_size(serialized_msg);
+      field.element_size = get_character_size(member->type_id_);
+      field.data = serialized_msg;
+      field.size = string_size;
+      serialized_msg += string_size * field.element_size;
+    } else {
+      field.data = serialized_msg;
+      field.size = count;
+      for (size_t i = 0; i < count; ++i) {
+        serialized_msg = skip_string(serialized_msg, member);
+      }
+    }
+  } else {
+    field.element_size = get_primitive_size(member->type_id_);
+    if (field.element_size == 0u) {
+      throw std::runtime_error(std::string("unsupported type for field ") + member->name_);
+    }
+    field.data = serialized_msg;
+    field.size = count;
+    serialized_msg += count * field.element_size;
+  }
+  return serialized_msg;
+}
+
+template<typename MembersT>
+const char * index_serialized(
+  const char * serialized_msg,
+  const MembersT * members,
+  std::vector<MessageView::Field> * fields)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    MessageView::Field field;
+    serialized_msg = index_serialized_field<MembersT>(
+      serialized_msg, members->members_ + i, field);
+    if (fields) {
+      fields->push_back(field);
+    }
+  }
+  return serialized_msg;
+}
+
+/// @brief Fixed size messages are sent as plain copy, so the members are found at their offsets
+template<typename MembersT>
+void index_fixed_size(
+  const char * payload,
+  const MembersT * members,
+  std::vector<MessageView::Field> & fields)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    MessageView::Field field;
+    field.name = member->name_;
+    field.type_id = member->type_id_;
+    field.is_array = member->is_array_;
+    field.data = payload + member->offset_;
+    field.size = member->is_array_ ? member->array_size_ : 1u;
+    if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+      auto sub_members = static_cast<const MembersT *>(member->members_->data);
+      field.sub_members = sub_members;
+      field.element_size = sub_members->size_of_;
+    } else {
+      field.element_size = get_primitive_size(member->type_id_);
+    }
+    fields.push_back(field);
+  }
+}
+
+/// @brief Flat messages are C structs whose strings and sequences are stored behind them
+template<typename MembersT>
+void index_flat(
+  const char * chunk,
+  size_t chunk_size,
+  const char * message,
+  const MembersT * members,
+  std::vector<MessageView::Field> & fields)
+{
+  details_flat::for_each_member(
+    members, [&](auto member, size_t offset) {
+      MessageView::Field field;
+      field.name = member->name_;
+      field.type_id = member->type_id_;
+      field.is_array = member->is_array_;
+      field.data = message + offset;
+      field.size = 1u;
+
+      const size_t element_size = details_flat::element_layout<MembersT>(member).size;
+      if (member->is_array_) {
+        if (member->array_size_ > 0 && !member->is_upper_bound_) {
+          field.size = member->array_size_;
+        } else {
+          auto sequence = reinterpret_cast<const details_flat::FlatSequence *>(field.data);
+          field.data = details_flat::resolve(chunk, chunk_size, sequence, element_size);
+          field.size = sequence->size;
+        }
+      }
+
+      if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+        field.sub_members = member->members_->data;
+        field.element_size = element_size;
+      } else if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_STRING) {
+        if (!member->is_array_) {
+          auto string = reinterpret_cast<const details_flat::FlatSequence *>(field.data);
+          field.data = details_flat::resolve(chunk, chunk_size, string, sizeof(char));
+          field.size = string->size;
+          field.element_size = sizeof(char);
+        }
+      } else {
+        field.element_size = element_size;
+      }
+      fields.push_back(field);
+    });
+}
+
+template<typename MembersT>
+void index_fields(
+  const char * chunk,
+  size_t chunk_size,
+  const char * payload,
+  const MembersT * members,
+  PayloadLayout layout,
+  std::vector<MessageView::Field> & fields)
+{
+  fields.reserve(members->member_count_);
+  switch (layout) {
+    case PayloadLayout::FIXED_SIZE:
+      index_fixed_size(payload, members, fields);
+      break;
+    case PayloadLayout::FLAT:
+      index_flat(chunk, chunk_size, payload, members, fields);
+      break;
+    default:
+      index_serialized(payload, members, &fields);
+      break;
+  }
+}
+
+}  // namespace details
+
+MessageView::MessageView(
+  const void * payload,
+  size_t payload_size,
+  const rosidl_message_type_support_t * type_supports,
+  PayloadLayout layout)
+: payload_(static_cast<const char *>(payload)),
+  chunk_(static_cast<const char *>(payload)),
+  chunk_size_(payload_size),
+  layout_(layout)
+{
+  auto ts = get_type_support(type_supports);
+  language_ = ts.first;
+  index_fields(ts.second->data);
+}
+
+MessageView::MessageView(
+  const MessageView & parent,
+  const void * message,
+  const void * members)
+: payload_(static_cast<const char *>(message)),
+  chunk_(parent.chunk_),
+  chunk_size_(parent.chunk_size_),
+  language_(parent.language_),
+  layout_(parent.layout_)
+{
+  index_fields(members);
+}
+
+void MessageView::index_fields(const void * members)
+{
+  if (language_ == TypeSupportLanguage::CPP) {
+    details::index_fields(
+      chunk_, chunk_size_, payload_,
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(members),
+      layout_, fields_);
+  } else {
+    details::index_fields(
+      chunk_, chunk_size_, payload_,
+      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(members),
+      layout_, fields_);
+  }
+}
+
+size_t MessageView::field_index(const std::string & name) const
+{
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (name == fields_[i].name) {
+      return i;
+    }
+  }
+  return fields_.size();
+}
+
+std::pair<const char *, size_t> MessageView::get_string(size_t index) const
+{
+  const Field & f = field(index);
+  if (!is_string_type(f.type_id) || f.is_array) {
+    throw std::runtime_error(std::string("field is not a string: ") + f.name);
+  }
+  return std::make_pair(f.data, f.size);
+}
+
+MessageView MessageView::get_message(size_t index) const
+{
+  const Field & f = field(index);
+  if (f.type_id != rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE || f.is_array) {
+    throw std::runtime_error(std::string("field is not a nested message: ") + f.name);
+  }
+  return MessageView(*this, f.data, f.sub_members);
+}
+
+}  // namespace rmw_iceoryx_cpp
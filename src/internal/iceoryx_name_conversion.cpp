@@ -13,10 +13,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
 #include <iostream>
+#include <mutex>
 #include <regex>
+#include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 
 #include "rcpputils/split.hpp"
 
@@ -37,6 +43,10 @@
 
 static constexpr char ARA_DELIMITER[] = "_ara_msgs/msg/";
 static constexpr char ROS2_EVENT_NAME[] = "data";
+static constexpr char ROS2_REQUEST_PREFIX[] = "rq";
+static constexpr char ROS2_REQUEST_SUFFIX[] = "Request";
+static constexpr char ROS2_RESPONSE_PREFIX[] = "rr";
+static constexpr char ROS2_RESPONSE_SUFFIX[] = "Reply";
 static constexpr char ICEORYX_INTROSPECTION_SERVICE[] = "Introspection";
 static constexpr char ICEORYX_INTROSPECTION_MSG_PACKAGE[] = "iceoryx_introspection_msgs";
 
@@ -77,8 +87,10 @@ get_name_n_space_from_node_full_name(
   return std::make_tuple(node_name, node_namespace);
 }
 
+namespace details
+{
 std::tuple<std::string, std::string>
-get_name_n_type_from_service_description(
+convert_service_description(
   const std::string & service,
   const std::string & instance,
   const std::string & event)
@@ -112,7 +124,7 @@ get_name_n_type_from_service_description(
 }
 
 std::tuple<std::string, std::string, std::string>
-get_service_description_from_name_n_type(
+convert_name_n_type(
   const std::string & topic_name,
   const std::string & type_name)
 {
@@ -159,6 +171,121 @@ get_service_description_from_name_n_type(
   return std::make_tuple(service, instance, event);
 }
 
+/// @brief Memo of the conversions between (topic, type) and (service, instance, event)
+/// Both directions are memoized, each unique name is converted once and then costs a hash lookup.
+class ConversionCache
+{
+public:
+  using NameAndType = std::tuple<std::string, std::string>;
+  using ServiceDescription = std::tuple<std::string, std::string, std::string>;
+
+  NameAndType to_name_n_type(
+    const std::string & service,
+    const std::string & instance,
+    const std::string & event)
+  {
+    auto & key = make_key({&service, &instance, &event});
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto known = names_n_types_.find(key);
+      if (known != names_n_types_.end()) {
+        return known->second;
+      }
+    }
+
+    auto name_n_type = convert_service_description(service, instance, event);
+    // the inverse conversion is only memoized if it leads back to the same description
+    bool is_inverse = false;
+    try {
+      is_inverse = convert_name_n_type(std::get<0>(name_n_type), std::get<1>(name_n_type)) ==
+        std::make_tuple(service, instance, event);
+    } catch (const std::runtime_error &) {
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    names_n_types_.emplace(key, name_n_type);
+    if (is_inverse) {
+      service_descriptions_.emplace(
+        make_key({&std::get<0>(name_n_type), &std::get<1>(name_n_type)}),
+        std::make_tuple(service, instance, event));
+    }
+    return name_n_type;
+  }
+
+  /// @throws std::runtime_error if the names can't be converted, which is not memoized
+  ServiceDescription to_service_description(
+    const std::string & topic_name,
+    const std::string & type_name)
+  {
+    auto & key = make_key({&topic_name, &type_name});
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto known = service_descriptions_.find(key);
+      if (known != service_descriptions_.end()) {
+        return known->second;
+      }
+    }
+
+    auto service_description = convert_name_n_type(topic_name, type_name);
+    bool is_inverse = convert_service_description(
+      std::get<0>(service_description), std::get<1>(service_description),
+      std::get<2>(service_description)) == std::make_tuple(topic_name, type_name);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    service_descriptions_.emplace(key, service_description);
+    if (is_inverse) {
+      names_n_types_.emplace(
+        make_key(
+          {&std::get<0>(service_description), &std::get<1>(service_description),
+            &std::get<2>(service_description)}),
+        std::make_tuple(topic_name, type_name));
+    }
+    return service_description;
+  }
+
+private:
+  /// @brief Joins the parts with a separator which is not part of any name
+  /// @return a thread local buffer, which does not allocate once it is large enough
+  static const std::string & make_key(std::initializer_list<const std::string *> parts)
+  {
+    thread_local std::string key;
+    key.clear();
+    for (auto part : parts) {
+      key.append(*part);
+      key.push_back('\0');
+    }
+    return key;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, NameAndType> names_n_types_;
+  std::unordered_map<std::string, ServiceDescription> service_descriptions_;
+};
+
+ConversionCache & conversion_cache()
+{
+  static ConversionCache cache;
+  return cache;
+}
+}  // namespace details
+
+std::tuple<std::string, std::string>
+get_name_n_type_from_service_description(
+  const std::string & service,
+  const std::string & instance,
+  const std::string & event)
+{
+  return details::conversion_cache().to_name_n_type(service, instance, event);
+}
+
+std::tuple<std::string, std::string, std::string>
+get_service_description_from_name_n_type(
+  const std::string & topic_name,
+  const std::string & type_name)
+{
+  return details::conversion_cache().to_service_description(topic_name, type_name);
+}
+
 iox::capro::ServiceDescription
 get_iceoryx_service_description(
   const std::string & topic_name,
@@ -177,4 +304,80 @@ get_iceoryx_service_description(
     iox::capro::IdString_t(iox::cxx::TruncateToCapacity, std::get<2>(serviceDescriptionTuple)));
 }
 
+namespace details
+{
+/// @return true if instance is `<prefix><service_name><suffix>` with a service name starting
+/// with a `/`
+bool matches_service_instance(const char * instance, const char * prefix, const char * suffix)
+{
+  auto size = std::strlen(instance);
+  auto prefix_size = std::strlen(prefix);
+  auto suffix_size = std::strlen(suffix);
+  return size > prefix_size + suffix_size &&
+         0 == std::strncmp(instance, prefix, prefix_size) && instance[prefix_size] == '/' &&
+         0 == std::strcmp(instance + size - suffix_size, suffix);
+}
+}  // namespace details
+
+bool
+is_service_instance(const char * instance)
+{
+  return details::matches_service_instance(instance, ROS2_REQUEST_PREFIX, ROS2_REQUEST_SUFFIX) ||
+         details::matches_service_instance(instance, ROS2_RESPONSE_PREFIX, ROS2_RESPONSE_SUFFIX);
+}
+
+std::tuple<std::string, std::string>
+get_service_name_n_type_from_request_description(
+  const std::string & service,
+  const std::string & instance)
+{
+  if (!details::matches_service_instance(
+      instance.c_str(), ROS2_REQUEST_PREFIX, ROS2_REQUEST_SUFFIX))
+  {
+    return std::make_tuple(std::string(), std::string());
+  }
+  auto prefix_size = std::strlen(ROS2_REQUEST_PREFIX);
+  auto service_name = instance.substr(
+    prefix_size, instance.size() - prefix_size - std::strlen(ROS2_REQUEST_SUFFIX));
+
+  // the request type is `<package>/srv/<service type>_Request`
+  static constexpr char REQUEST_TYPE_SUFFIX[] = "_Request";
+  constexpr size_t suffix_size = sizeof(REQUEST_TYPE_SUFFIX) - 1u;
+  auto service_type = service;
+  if (service_type.size() > suffix_size &&
+    0 == service_type.compare(
+      service_type.size() - suffix_size, suffix_size, REQUEST_TYPE_SUFFIX))
+  {
+    service_type.resize(service_type.size() - suffix_size);
+  }
+  return std::make_tuple(service_name, service_type);
+}
+
+iox::capro::ServiceDescription
+get_iceoryx_request_service_description(
+  const std::string & service_name,
+  const rosidl_message_type_support_t * request_type_supports)
+{
+  return get_iceoryx_service_description(
+    ROS2_REQUEST_PREFIX + service_name + ROS2_REQUEST_SUFFIX, request_type_supports);
+}
+
+iox::capro::ServiceDescription
+get_iceoryx_response_service_description(
+  const std::string & service_name,
+  const rosidl_message_type_support_t * response_type_supports,
+  const std::string & client_id)
+{
+  std::string package_name;
+  std::string type_name;
+  extract_type(response_type_supports, package_name, type_name);
+  type_name = package_name + "/" + type_name;
+
+  return iox::capro::ServiceDescription(
+    iox::capro::IdString_t(iox::cxx::TruncateToCapacity, type_name),
+    iox::capro::IdString_t(
+      iox::cxx::TruncateToCapacity, ROS2_RESPONSE_PREFIX + service_name + ROS2_RESPONSE_SUFFIX),
+    iox::capro::IdString_t(iox::cxx::TruncateToCapacity, client_id));
+}
+
 }  // namespace rmw_iceoryx_cpp
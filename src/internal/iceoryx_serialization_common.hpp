@@ -21,6 +21,8 @@
 #include <utility>
 #include <vector>
 
+#include "rosidl_typesupport_introspection_c/field_types.h"
+
 namespace rmw_iceoryx_cpp
 {
 
@@ -63,6 +65,46 @@ inline std::pair<const char *, uint32_t> pop_sequence_size(const char * serializ
   return std::make_pair(serialized_msg, array_size);
 }
 
+/// @brief size of a primitive type in the serialized format, 0 for non-primitive types
+/// @note the type ids of the C++ introspection are aliases of the C ones
+inline size_t get_primitive_size(uint8_t type_id)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOL:
+      return sizeof(bool);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BYTE:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      return sizeof(uint8_t);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+      return sizeof(uint16_t);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT32:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+      return sizeof(uint32_t);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT64:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+      return sizeof(uint64_t);
+    default:
+      return 0u;
+  }
+}
+
+inline size_t get_character_size(uint8_t type_id)
+{
+  return type_id == rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING ?
+         sizeof(wchar_t) : sizeof(char);
+}
+
+inline bool is_string_type(uint8_t type_id)
+{
+  return type_id == rosidl_typesupport_introspection_c__ROS_TYPE_STRING ||
+         type_id == rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING;
+}
+
 namespace details_c
 {
 namespace traits
@@ -33,6 +33,46 @@
 
 namespace rmw_iceoryx_cpp
 {
+namespace details
+{
+
+/// size of the check value and the size which preceed every sequence and string
+constexpr size_t SEQUENCE_HEADER_SIZE = 2u * sizeof(uint32_t);
+
+template<typename MembersT>
+size_t get_serialized_size_upper_bound(const MembersT * members)
+{
+  size_t size = 0u;
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+
+    size_t element_size = 0u;
+    if (member->type_id_ == rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE) {
+      element_size = get_serialized_size_upper_bound(
+        static_cast<const MembersT *>(member->members_->data));
+    } else if (is_string_type(member->type_id_)) {
+      if (member->string_upper_bound_ > 0) {
+        element_size = SEQUENCE_HEADER_SIZE +
+          member->string_upper_bound_ * get_character_size(member->type_id_);
+      }
+    } else {
+      element_size = get_primitive_size(member->type_id_);
+    }
+    if (element_size == 0u || (member->is_array_ && member->array_size_ == 0)) {
+      return 0u;
+    }
+
+    if (!member->is_array_) {
+      size += element_size;
+    } else if (!member->is_upper_bound_) {
+      size += member->array_size_ * element_size;
+    } else {
+      size += SEQUENCE_HEADER_SIZE + member->array_size_ * element_size;
+    }
+  }
+  return size;
+}
+}  // namespace details
 
 void serialize(
   const void * ros_message,
@@ -52,4 +92,18 @@ void serialize(
   }
 }
 
+size_t get_serialized_size_upper_bound(const rosidl_message_type_support_t * type_supports)
+{
+  auto ts = get_type_support(type_supports);
+
+  if (ts.first == TypeSupportLanguage::CPP) {
+    auto members =
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
+    return details::get_serialized_size_upper_bound(members);
+  }
+  auto members =
+    static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
+  return details::get_serialized_size_upper_bound(members);
+}
+
 }  // namespace rmw_iceoryx_cpp
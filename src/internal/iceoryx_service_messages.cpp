@@ -0,0 +1,206 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../iceoryx_service_messages.hpp"
+#include "../iceoryx_user_header.hpp"
+#include "../types/iceoryx_service.hpp"
+
+#include "iceoryx_posh/iceoryx_posh_types.hpp"
+
+#include "rcutils/error_handling.h"
+#include "rcutils/time.h"
+
+#include "rmw/error_handling.h"
+
+#include "rmw_iceoryx_cpp/iceoryx_deserialize.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_serialize.hpp"
+
+std::string client_id_to_string(const int8_t * client_id)
+{
+  static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+  std::string result;
+  result.reserve(2u * CLIENT_ID_SIZE);
+  for (size_t i = 0u; i < CLIENT_ID_SIZE; ++i) {
+    auto byte = static_cast<uint8_t>(client_id[i]);
+    result.push_back(HEX_DIGITS[byte >> 4u]);
+    result.push_back(HEX_DIGITS[byte & 0xfu]);
+  }
+  return result;
+}
+
+rmw_ret_t send_service_message(
+  iox::popo::UntypedPublisher * iceoryx_sender,
+  const IceoryxServiceMessageType & message_type,
+  const void * ros_message,
+  const int8_t * client_id,
+  int64_t sequence_number)
+{
+  // fixed size messages are copied as they are, all others are serialized first
+  std::vector<char> payload_vector{};
+  const void * payload = ros_message;
+  size_t payload_size = message_type.message_size_;
+  if (!message_type.is_fixed_size_) {
+    try {
+      rmw_iceoryx_cpp::serialize(ros_message, &message_type.type_supports_, payload_vector);
+    } catch (const std::exception & e) {
+      RMW_SET_ERROR_MSG(e.what());
+      return RMW_RET_ERROR;
+    }
+    payload = payload_vector.data();
+    payload_size = payload_vector.size();
+  }
+
+  rmw_ret_t ret = RMW_RET_ERROR;
+  iceoryx_sender->loan(
+    static_cast<uint32_t>(payload_size),
+    iox::CHUNK_DEFAULT_USER_PAYLOAD_ALIGNMENT,
+    sizeof(IceoryxUserHeader),
+    alignof(IceoryxUserHeader))
+  .and_then(
+    [&](void * userPayload) {
+      auto user_header = new (get_user_header(userPayload)) IceoryxUserHeader();
+      memcpy(user_header->publisher_gid, client_id, CLIENT_ID_SIZE);
+      user_header->sequence_number = static_cast<uint64_t>(sequence_number);
+      (void) rcutils_system_time_now(&user_header->source_timestamp);
+      memcpy(userPayload, payload, payload_size);
+      iceoryx_sender->publish(userPayload);
+      ret = RMW_RET_OK;
+    })
+  .or_else(
+    [&](iox::popo::AllocationError) {
+      RMW_SET_ERROR_MSG("failed to loan a chunk");
+      ret = RMW_RET_ERROR;
+    });
+
+  return ret;
+}
+
+rmw_ret_t take_service_message(
+  iox::popo::UntypedSubscriber * iceoryx_receiver,
+  const IceoryxServiceMessageType & message_type,
+  void * ros_message,
+  rmw_service_info_t * service_info,
+  bool * taken)
+{
+  *taken = false;
+
+  const void * user_payload = nullptr;
+  rmw_ret_t ret = RMW_RET_OK;
+  iceoryx_receiver->take()
+  .and_then(
+    [&](const void * userPayload) {
+      user_payload = userPayload;
+    })
+  .or_else(
+    [&](iox::popo::ChunkReceiveResult result) {
+      // a guard condition or another waiter might have woken us up, that's not an error
+      if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
+        RMW_SET_ERROR_MSG("failed to take a chunk");
+        ret = RMW_RET_ERROR;
+      }
+    });
+  if (!user_payload) {
+    return ret;
+  }
+
+  // without the client id and sequence number the message can't be matched, it is dropped
+  auto user_header = get_user_header(user_payload);
+  if (!user_header) {
+    iceoryx_receiver->release(user_payload);
+    RMW_SET_ERROR_MSG("dropped a request or response without user header");
+    return RMW_RET_ERROR;
+  }
+  memcpy(service_info->request_id.writer_guid, user_header->publisher_gid, CLIENT_ID_SIZE);
+  service_info->request_id.sequence_number = static_cast<int64_t>(user_header->sequence_number);
+  service_info->source_timestamp = user_header->source_timestamp;
+  (void) rcutils_system_time_now(&service_info->received_timestamp);
+
+  if (message_type.is_fixed_size_) {
+    memcpy(ros_message, user_payload, message_type.message_size_);
+  } else {
+    try {
+      rmw_iceoryx_cpp::deserialize(
+        static_cast<const char *>(user_payload), &message_type.type_supports_, ros_message);
+    } catch (const std::exception & e) {
+      RMW_SET_ERROR_MSG(e.what());
+      ret = RMW_RET_ERROR;
+    }
+  }
+  iceoryx_receiver->release(user_payload);
+  *taken = (ret == RMW_RET_OK);
+
+  return ret;
+}
+
+void drop_response_senders(IceoryxService * iceoryx_service)
+{
+  auto & response_senders = iceoryx_service->response_senders_;
+  auto least_recently_used = response_senders.end();
+  for (auto it = response_senders.begin(); it != response_senders.end(); ) {
+    auto & response_sender = it->second;
+    bool has_subscriber = response_sender.publisher_->hasSubscribers();
+    if (response_sender.had_subscriber_ && !has_subscriber) {
+      it = response_senders.erase(it);
+      continue;
+    }
+    response_sender.had_subscriber_ |= has_subscriber;
+    if (least_recently_used == response_senders.end() ||
+      response_sender.last_response_ < least_recently_used->second.last_response_)
+    {
+      least_recently_used = it;
+    }
+    ++it;
+  }
+  if (response_senders.size() >= IceoryxService::MAX_RESPONSE_SENDERS) {
+    response_senders.erase(least_recently_used);
+  }
+}
+
+iox::popo::UntypedPublisher *
+get_response_sender(IceoryxService * iceoryx_service, const int8_t * client_id)
+{
+  std::string client = client_id_to_string(client_id);
+
+  std::lock_guard<std::mutex> lock(iceoryx_service->response_senders_mutex_);
+  auto known = iceoryx_service->response_senders_.find(client);
+  if (known == iceoryx_service->response_senders_.end()) {
+    drop_response_senders(iceoryx_service);
+    std::unique_ptr<iox::popo::UntypedPublisher> publisher(
+      new (std::nothrow) iox::popo::UntypedPublisher(
+        rmw_iceoryx_cpp::get_iceoryx_response_service_description(
+          iceoryx_service->service_name_, &iceoryx_service->response_type_.type_supports_,
+          client),
+        iox::popo::PublisherOptions{
+          iceoryx_service->response_history_,
+          iox::NodeName_t(iox::cxx::TruncateToCapacity, iceoryx_service->node_full_name_)}));
+    if (!publisher) {
+      return nullptr;
+    }
+    publisher->offer();
+    known = iceoryx_service->response_senders_.emplace(
+      client, IceoryxResponseSender{std::move(publisher), false, 0u}).first;
+  }
+  known->second.last_response_ = ++iceoryx_service->response_count_;
+  return known->second.publisher_.get();
+}
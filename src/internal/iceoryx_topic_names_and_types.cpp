@@ -13,216 +13,169 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "iceoryx_posh/popo/untyped_subscriber.hpp"
-#include "iceoryx_posh/roudi/introspection_types.hpp"
-
 #include "rcutils/logging_macros.h"
 #include "rcutils/strdup.h"
 
 #include "rmw/impl/cpp/macros.hpp"
 
-#include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_topic_names_and_types.hpp"
 
 namespace rmw_iceoryx_cpp
 {
 
-/// @todo Use the new service discovery API of iceoryx v2.0 here instead of introspection topics
-void fill_topic_containers(
-  std::map<std::string, std::string> & names_n_types_,
-  std::map<std::string, std::vector<std::string>> & subscribers_topics_,
-  std::map<std::string, std::vector<std::string>> & publishers_topics_,
-  std::map<std::string, std::vector<std::string>> & topic_subscribers_,
-  std::map<std::string, std::vector<std::string>> & topic_publishers_)
+namespace details
 {
-  static iox::popo::UntypedSubscriber port_receiver(iox::roudi::IntrospectionPortService,
-    iox::popo::SubscriberOptions{1U, 1U, "", true});
-  static std::map<std::string, std::string> names_n_types;
-  static std::map<std::string, std::vector<std::string>> subscribers_topics;
-  static std::map<std::string, std::vector<std::string>> publishers_topics;
-  static std::map<std::string, std::vector<std::string>> topic_subscribers;
-  static std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  bool updated = false;
-  if (iox::SubscribeState::SUBSCRIBED != port_receiver.getSubscriptionState()) {
-    port_receiver.subscribe();
-    // wait for delivery on subscribe
-    while (!port_receiver.hasData()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+/// @brief Adds the topics of the endpoints of one kind to the maps of the public API
+void copy_endpoints(
+  const GraphCache::Graph & graph,
+  std::vector<GraphCache::Endpoint> GraphCache::Topic::* topic_endpoints,
+  std::map<std::string, std::vector<std::string>> & nodes_topics,
+  std::map<std::string, std::vector<std::string>> & topics_nodes)
+{
+  for (const auto & topic : graph.topics) {
+    const auto & topic_name = graph.names.name(topic.first);
+    for (const auto & endpoint : topic.second.*topic_endpoints) {
+      const auto & node_name = graph.names.name(endpoint.node);
+      nodes_topics[node_name].push_back(topic_name);
+      topics_nodes[topic_name].push_back(node_name);
     }
-    updated = true;
-  } else {
-    updated = port_receiver.hasData();
   }
+}
 
-  if (updated) {
-    // get the latest sample
-    const void * previous_user_payload = nullptr;
-
-    while (port_receiver.take()
-      .and_then(
-        [&](const void * userPayload) {
-          if (previous_user_payload) {
-            port_receiver.release(previous_user_payload);
-          }
-          previous_user_payload = userPayload;
-        })
-      .or_else(
-        [](auto & result) {
-          if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
-            RMW_SET_ERROR_MSG("failed to take message");
-          }
-        }))
+std::map<std::string, std::string> get_names_and_types(const GraphCache::Graph & graph)
+{
+  std::map<std::string, std::string> names_n_types;
+  for (const auto & topic : graph.topics) {
+    names_n_types.emplace(graph.names.name(topic.first), graph.names.name(topic.second.type));
+  }
+  return names_n_types;
+}
 
-    {
+std::map<std::string, std::vector<std::string>> get_nodes_topics(
+  const GraphCache::Graph & graph,
+  std::vector<GraphCache::Id> GraphCache::Node::* node_topics)
+{
+  std::map<std::string, std::vector<std::string>> nodes_topics;
+  for (const auto & node : graph.nodes) {
+    const auto & topics = node.second.*node_topics;
+    if (topics.empty()) {
+      continue;
     }
+    auto & topic_names = nodes_topics[graph.names.name(node.first)];
+    for (auto topic : topics) {
+      topic_names.push_back(graph.names.name(topic));
+    }
+  }
+  return nodes_topics;
+}
 
-    if (previous_user_payload) {
-      const iox::roudi::PortIntrospectionFieldTopic * port_sample =
-        static_cast<const iox::roudi::PortIntrospectionFieldTopic *>(previous_user_payload);
-
-      names_n_types.clear();
-      subscribers_topics.clear();
-      publishers_topics.clear();
-
-      for (auto & receiver : port_sample->m_subscriberList) {
-        auto name_and_type = rmw_iceoryx_cpp::get_name_n_type_from_service_description(
-          std::string(receiver.m_caproServiceID.c_str()),
-          std::string(receiver.m_caproInstanceID.c_str()),
-          std::string(receiver.m_caproEventMethodID.c_str()));
-
-        names_n_types[std::get<0>(name_and_type)] = std::get<1>(name_and_type);
-        subscribers_topics[std::string(receiver.m_node.c_str())].push_back(
-          std::get<0>(
-            name_and_type));
-        topic_subscribers[std::get<0>(name_and_type)].push_back(
-          std::string(receiver.m_node.c_str()));
-      }
-      for (auto & sender : port_sample->m_publisherList) {
-        auto name_and_type = rmw_iceoryx_cpp::get_name_n_type_from_service_description(
-          std::string(sender.m_caproServiceID.c_str()),
-          std::string(sender.m_caproInstanceID.c_str()),
-          std::string(sender.m_caproEventMethodID.c_str()));
+std::map<std::string, std::string> get_names_and_types_of_node(
+  const GraphCache::Graph & graph,
+  std::vector<GraphCache::Id> GraphCache::Node::* node_topics,
+  const std::string & full_name)
+{
+  std::map<std::string, std::string> node_names_and_types;
 
-        names_n_types[std::get<0>(name_and_type)] = std::get<1>(name_and_type);
-        publishers_topics[std::string(sender.m_node.c_str())].push_back(
-          std::get<0>(
-            name_and_type));
-        topic_publishers[std::get<0>(name_and_type)].push_back(std::string(sender.m_node.c_str()));
-      }
-      port_receiver.release(previous_user_payload);
+  auto node = graph.find_node(full_name);
+  if (!node) {
+    return node_names_and_types;
+  }
+  for (auto topic : node->*node_topics) {
+    auto graph_topic = graph.topics.find(topic);
+    if (graph_topic != graph.topics.end()) {
+      node_names_and_types.emplace(
+        graph.names.name(topic), graph.names.name(graph_topic->second.type));
     }
   }
+  return node_names_and_types;
+}
+}  // namespace details
 
-  names_n_types_ = names_n_types;
-  subscribers_topics_ = subscribers_topics;
-  publishers_topics_ = publishers_topics;
-  topic_subscribers_ = topic_subscribers;
-  topic_publishers_ = topic_publishers;
+void fill_topic_containers(
+  std::map<std::string, std::string> & names_n_types_,
+  std::map<std::string, std::vector<std::string>> & subscribers_topics_,
+  std::map<std::string, std::vector<std::string>> & publishers_topics_,
+  std::map<std::string, std::vector<std::string>> & topic_subscribers_,
+  std::map<std::string, std::vector<std::string>> & topic_publishers_)
+{
+  get_graph_cache().read(
+    [&](const GraphCache::Graph & graph) {
+      names_n_types_ = details::get_names_and_types(graph);
+      subscribers_topics_.clear();
+      publishers_topics_.clear();
+      topic_subscribers_.clear();
+      topic_publishers_.clear();
+      details::copy_endpoints(
+        graph, &GraphCache::Topic::subscribers, subscribers_topics_, topic_subscribers_);
+      details::copy_endpoints(
+        graph, &GraphCache::Topic::publishers, publishers_topics_, topic_publishers_);
+    });
 }
 
 std::map<std::string, std::string> get_topic_names_and_types()
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
-
-  return names_n_types;
+  return get_graph_cache().read(
+    [](const GraphCache::Graph & graph) {
+      return details::get_names_and_types(graph);
+    });
 }
 
 std::map<std::string, std::vector<std::string>> get_nodes_and_publishers()
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
-
-  return publishers_topics;
+  return get_graph_cache().read(
+    [](const GraphCache::Graph & graph) {
+      return details::get_nodes_topics(graph, &GraphCache::Node::publishers);
+    });
 }
 
 std::map<std::string, std::vector<std::string>> get_nodes_and_subscribers()
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
-
-  return subscribers_topics;
+  return get_graph_cache().read(
+    [](const GraphCache::Graph & graph) {
+      return details::get_nodes_topics(graph, &GraphCache::Node::subscribers);
+    });
 }
 
 std::map<std::string, std::string> get_publisher_names_and_types_of_node(
   const char * node_name,
   const char * node_namespace)
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
-
-  std::map<std::string, std::string> publisher_names_and_types;
-
   std::string full_name = std::string(node_namespace) + std::string(node_name);
 
-  auto publisher_topics = publishers_topics[full_name];
-  for (auto topic : publisher_topics) {
-    publisher_names_and_types[topic] = names_n_types[topic];
-  }
-  return publisher_names_and_types;
+  return get_graph_cache().read(
+    [&](const GraphCache::Graph & graph) {
+      return details::get_names_and_types_of_node(
+        graph, &GraphCache::Node::publishers, full_name);
+    });
 }
 
 std::map<std::string, std::string> get_subscription_names_and_types_of_node(
   const char * node_name,
   const char * node_namespace)
 {
-  std::map<std::string, std::string> names_n_types;
-  std::map<std::string, std::vector<std::string>> subscribers_topics;
-  std::map<std::string, std::vector<std::string>> publishers_topics;
-  std::map<std::string, std::vector<std::string>> topic_subscribers;
-  std::map<std::string, std::vector<std::string>> topic_publishers;
-
-  fill_topic_containers(
-    names_n_types, subscribers_topics, publishers_topics, topic_subscribers,
-    topic_publishers);
-
-  std::map<std::string, std::string> subscriber_names_and_types;
-
   std::string full_name = std::string(node_namespace) + std::string(node_name);
 
-  auto subscriber_topics = subscribers_topics[full_name];
-  for (auto topic : subscriber_topics) {
-    subscriber_names_and_types[topic] = names_n_types[topic];
-  }
-  return subscriber_names_and_types;
+  return get_graph_cache().read(
+    [&](const GraphCache::Graph & graph) {
+      return details::get_names_and_types_of_node(
+        graph, &GraphCache::Node::subscribers, full_name);
+    });
 }
 
+namespace details
+{
+/// @param iceoryx_topic_names_and_types range of pairs of topic name and type
+template<typename NamesAndTypesT>
 rmw_ret_t fill_rmw_names_and_types(
   rmw_names_and_types_t * rmw_topic_names_and_types,
-  const std::map<std::string, std::string> & iceoryx_topic_names_and_types,
+  const NamesAndTypesT & iceoryx_topic_names_and_types,
   rcutils_allocator_t * allocator)
 {
   rmw_ret_t rmw_ret = RMW_RET_ERROR;
@@ -278,4 +231,71 @@ fail:
   return RMW_RET_ERROR;
 }
 
+/// refers to the strings of the graph
+struct NameAndType
+{
+  const std::string & first;
+  const std::string & second;
+};
+}  // namespace details
+
+rmw_ret_t fill_rmw_names_and_types(
+  rmw_names_and_types_t * rmw_topic_names_and_types,
+  const std::map<std::string, std::string> & iceoryx_topic_names_and_types,
+  rcutils_allocator_t * allocator)
+{
+  return details::fill_rmw_names_and_types(
+    rmw_topic_names_and_types, iceoryx_topic_names_and_types, allocator);
+}
+
+namespace details
+{
+/// @brief Fills the names and types of a map of the graph, sorted like the other graph queries
+rmw_ret_t fill_rmw_names_and_types(
+  rmw_names_and_types_t * rmw_names_and_types,
+  const GraphCache::Graph & graph,
+  std::vector<std::pair<GraphCache::Id, GraphCache::Id>> & ids,
+  rcutils_allocator_t * allocator)
+{
+  std::sort(
+    ids.begin(), ids.end(),
+    [&graph](
+      const std::pair<GraphCache::Id, GraphCache::Id> & lhs,
+      const std::pair<GraphCache::Id, GraphCache::Id> & rhs) {
+      return graph.names.name(lhs.first) < graph.names.name(rhs.first);
+    });
+
+  std::vector<NameAndType> names_and_types;
+  names_and_types.reserve(ids.size());
+  for (auto & id : ids) {
+    names_and_types.push_back(NameAndType{graph.names.name(id.first), graph.names.name(id.second)});
+  }
+  return fill_rmw_names_and_types(rmw_names_and_types, names_and_types, allocator);
+}
+}  // namespace details
+
+rmw_ret_t fill_rmw_names_and_types(
+  rmw_names_and_types_t * rmw_topic_names_and_types,
+  const GraphCache::Graph & graph,
+  rcutils_allocator_t * allocator)
+{
+  std::vector<std::pair<GraphCache::Id, GraphCache::Id>> topics;
+  topics.reserve(graph.topics.size());
+  for (const auto & topic : graph.topics) {
+    topics.emplace_back(topic.first, topic.second.type);
+  }
+  return details::fill_rmw_names_and_types(rmw_topic_names_and_types, graph, topics, allocator);
+}
+
+rmw_ret_t fill_rmw_service_names_and_types(
+  rmw_names_and_types_t * rmw_service_names_and_types,
+  const GraphCache::Graph & graph,
+  rcutils_allocator_t * allocator)
+{
+  std::vector<std::pair<GraphCache::Id, GraphCache::Id>> services(
+    graph.services.begin(), graph.services.end());
+  return details::fill_rmw_names_and_types(
+    rmw_service_names_and_types, graph, services, allocator);
+}
+
 }  // namespace rmw_iceoryx_cpp
@@ -13,21 +13,29 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <sstream>
 
+#include "rosidl_runtime_c/service_type_support_struct.h"
+
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
 
 #include "rosidl_typesupport_introspection_c/field_types.h"
 #include "rosidl_typesupport_introspection_c/identifier.h"
 #include "rosidl_typesupport_introspection_c/message_introspection.h"
+#include "rosidl_typesupport_introspection_c/service_introspection.h"
 
 #include "rosidl_typesupport_introspection_cpp/field_types.hpp"
 #include "rosidl_typesupport_introspection_cpp/identifier.hpp"
 #include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+#include "rosidl_typesupport_introspection_cpp/service_introspection.hpp"
 
 #include "rcutils/error_handling.h"
 
@@ -46,36 +54,22 @@ bool is_vector_type(const rosidl_typesupport_introspection_cpp::MessageMember *
          (member->is_array_ && !(member->array_size_ > 0 && !member->is_upper_bound_));
 }
 
+/// @brief Only called once per type by the type registry, which caches the result
 bool is_fixed_size(const rosidl_typesupport_introspection_cpp::MessageMembers * members)
 {
-  static auto cache = std::unordered_map<std::string, bool>();
-
-  std::string name = members->message_namespace_;
-  name += members->message_name_;
-
-  auto search = cache.find(name);
-  if (search != cache.end()) {
-    return search->second;
-  }
-
   for (uint32_t i = 0; i < members->member_count_; ++i) {
     const auto * member = members->members_ + i;
     // if ROS type, call recursively
     if (is_complex_type(member)) {
-      auto result = is_fixed_size(
-        (const rosidl_typesupport_introspection_cpp::MessageMembers *)member->members_->data);
-      // early exit
-      if (!result) {
-        cache.insert({name, result});
+      if (!is_fixed_size(
+          (const rosidl_typesupport_introspection_cpp::MessageMembers *)member->members_->data))
+      {
         return false;
       }
     } else if (is_vector_type(member)) {
-      cache.insert({name, false});
       return false;
     }
   }
-
-  cache.insert({name, true});
   return true;
 }
 }  // namespace details_cpp
@@ -93,44 +87,32 @@ bool is_vector_type(const rosidl_typesupport_introspection_c__MessageMember * me
          (member->is_array_ && !(member->array_size_ > 0 && !member->is_upper_bound_));
 }
 
+/// @brief Only called once per type by the type registry, which caches the result
 bool is_fixed_size(const rosidl_typesupport_introspection_c__MessageMembers * members)
 {
-  static auto cache = std::unordered_map<std::string, bool>();
-
-  std::string name = members->message_namespace_;
-  name += members->message_name_;
-
-  auto search = cache.find(name);
-  if (search != cache.end()) {
-    return search->second;
-  }
-
   for (uint32_t i = 0; i < members->member_count_; ++i) {
     const auto * member = members->members_ + i;
     // if ROS type, call recursively
     if (is_complex_type(member)) {
-      auto result = is_fixed_size(
-        (const rosidl_typesupport_introspection_c__MessageMembers *)member->members_->data);
-      // early exit
-      if (!result) {
-        cache.insert({name, result});
+      if (!is_fixed_size(
+          (const rosidl_typesupport_introspection_c__MessageMembers *)member->members_->data))
+      {
         return false;
       }
     } else if (is_vector_type(member)) {
-      cache.insert({name, false});
       return false;
     }
   }
-
-  cache.insert({name, true});
   return true;
 }
 }  // namespace details_c
 
 namespace rmw_iceoryx_cpp
 {
+namespace details
+{
 const std::pair<rmw_iceoryx_cpp::TypeSupportLanguage,
-  const rosidl_message_type_support_t *> get_type_support(
+  const rosidl_message_type_support_t *> resolve_type_support(
   const rosidl_message_type_support_t * type_supports)
 {
   rcutils_error_string_t cpp_error_string;
@@ -167,78 +149,105 @@ const std::pair<rmw_iceoryx_cpp::TypeSupportLanguage,
   throw std::runtime_error(error_string.str());
 }
 
-bool iceoryx_is_fixed_size(const rosidl_message_type_support_t * type_supports)
+template<typename MessageMembersT>
+std::unique_ptr<TypeInfo> make_type_info(
+  TypeSupportLanguage language,
+  const rosidl_message_type_support_t * introspection_type_supports,
+  bool (* is_fixed_size)(const MessageMembersT *))
 {
-  auto ts = get_type_support(type_supports);
+  auto members = static_cast<const MessageMembersT *>(introspection_type_supports->data);
+  return std::unique_ptr<TypeInfo>(
+    new TypeInfo{language, introspection_type_supports, members, is_fixed_size(members),
+      members->size_of_, members->message_name_, members->message_namespace_});
+}
 
-  if (ts.first == TypeSupportLanguage::CPP) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
-    return details_cpp::is_fixed_size(members);
-  } else if (ts.first == TypeSupportLanguage::C) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
-    return details_c::is_fixed_size(members);
+/// Entries are created once per type and never removed
+class TypeRegistry
+{
+public:
+  const TypeInfo & get(const rosidl_message_type_support_t * type_supports)
+  {
+    // a type support handle is identified by its contents, handles might be copies
+    auto handle = std::make_pair(type_supports->typesupport_identifier, type_supports->data);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto known = handles_.find(handle);
+      if (known != handles_.end()) {
+        return *known->second;
+      }
+    }
+
+    // resolved outside of the lock, it might call into the type support libraries
+    auto ts = resolve_type_support(type_supports);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto & type_info = types_[ts.second->data];
+    if (!type_info) {
+      if (ts.first == TypeSupportLanguage::CPP) {
+        type_info = make_type_info(ts.first, ts.second, &details_cpp::is_fixed_size);
+      } else {
+        type_info = make_type_info(ts.first, ts.second, &details_c::is_fixed_size);
+      }
+    }
+    handles_.emplace(handle, type_info.get());
+    return *type_info;
   }
-  // Something went wrong
-  return false;
+
+private:
+  struct HandleHash
+  {
+    size_t operator()(const std::pair<const char *, const void *> & handle) const
+    {
+      return std::hash<const char *>()(handle.first) ^ std::hash<const void *>()(handle.second);
+    }
+  };
+
+  std::mutex mutex_;
+  /// keyed by the introspection MessageMembers of the types
+  std::unordered_map<const void *, std::unique_ptr<TypeInfo>> types_;
+  /// type support handles which were looked up before
+  std::unordered_map<std::pair<const char *, const void *>, const TypeInfo *, HandleHash> handles_;
+};
+}  // namespace details
+
+const TypeInfo & iceoryx_get_type_info(const rosidl_message_type_support_t * type_supports)
+{
+  static details::TypeRegistry registry;
+  return registry.get(type_supports);
 }
 
-size_t iceoryx_get_message_size(const rosidl_message_type_support_t * type_supports)
+const std::pair<rmw_iceoryx_cpp::TypeSupportLanguage,
+  const rosidl_message_type_support_t *> get_type_support(
+  const rosidl_message_type_support_t * type_supports)
+{
+  auto & type_info = iceoryx_get_type_info(type_supports);
+  return std::make_pair(type_info.language, type_info.introspection_type_supports);
+}
+
+bool iceoryx_is_fixed_size(const rosidl_message_type_support_t * type_supports)
 {
-  auto ts = get_type_support(type_supports);
+  return iceoryx_get_type_info(type_supports).is_fixed_size;
+}
 
-  if (ts.first == TypeSupportLanguage::CPP) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
-    return members->size_of_;
-  } else if (ts.first == TypeSupportLanguage::C) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
-    return members->size_of_;
-  }
-  // Something went wrong
-  return 0;
+size_t iceoryx_get_message_size(const rosidl_message_type_support_t * type_supports)
+{
+  return iceoryx_get_type_info(type_supports).size;
 }
 
 std::string iceoryx_get_message_name(const rosidl_message_type_support_t * type_supports)
 {
-  auto ts = get_type_support(type_supports);
-
-  if (ts.first == TypeSupportLanguage::CPP) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
-    return members->message_name_;
-  } else if (ts.first == TypeSupportLanguage::C) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
-    return members->message_name_;
-  }
-  // Something went wrong
-  return "";
+  return iceoryx_get_type_info(type_supports).name;
 }
 
 std::string iceoryx_get_message_namespace(const rosidl_message_type_support_t * type_supports)
 {
-  auto ts = get_type_support(type_supports);
-
-  if (ts.first == TypeSupportLanguage::CPP) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
-    return members->message_namespace_;
-  } else if (ts.first == TypeSupportLanguage::C) {
-    auto members =
-      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
-    return members->message_namespace_;
-  }
-  // Something went wrong
-  return "";
+  return iceoryx_get_type_info(type_supports).namespace_;
 }
 
 bool iceoryx_is_valid_type_support(const rosidl_message_type_support_t * type_supports)
 {
   try {
-    get_type_support(type_supports);
+    iceoryx_get_type_info(type_supports);
   } catch (...) {
     return false;
   }
@@ -250,16 +259,16 @@ void iceoryx_init_message(
   const rosidl_message_type_support_t * type_supports,
   void * message)
 {
-  auto ts = get_type_support(type_supports);
+  auto & type_info = iceoryx_get_type_info(type_supports);
 
-  if (ts.first == TypeSupportLanguage::CPP) {
+  if (type_info.language == TypeSupportLanguage::CPP) {
     auto members =
-      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(type_info.members);
     members->init_function(message, rosidl_runtime_cpp::MessageInitialization::ALL);
     return;
-  } else if (ts.first == TypeSupportLanguage::C) {
+  } else if (type_info.language == TypeSupportLanguage::C) {
     auto members =
-      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
+      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(type_info.members);
     members->init_function(message, ROSIDL_RUNTIME_C_MSG_INIT_ALL);
     return;
   }
@@ -269,18 +278,58 @@ void iceoryx_fini_message(
   const rosidl_message_type_support_t * type_supports,
   void * message)
 {
-  auto ts = get_type_support(type_supports);
-  if (ts.first == TypeSupportLanguage::CPP) {
+  auto & type_info = iceoryx_get_type_info(type_supports);
+  if (type_info.language == TypeSupportLanguage::CPP) {
     auto members =
-      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(ts.second->data);
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(type_info.members);
     members->fini_function(message);
     return;
-  } else if (ts.first == TypeSupportLanguage::C) {
+  } else if (type_info.language == TypeSupportLanguage::C) {
     auto members =
-      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(ts.second->data);
+      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(type_info.members);
     members->fini_function(message);
     return;
   }
 }
 
+void iceoryx_get_service_message_type_supports(
+  const rosidl_service_type_support_t * type_supports,
+  rosidl_message_type_support_t * request_type_supports,
+  rosidl_message_type_support_t * response_type_supports)
+{
+  // first, try to extract cpp type support
+  auto ts_cpp = get_service_typesupport_handle(
+    type_supports, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+  if (ts_cpp != nullptr) {
+    auto members =
+      static_cast<const rosidl_typesupport_introspection_cpp::ServiceMembers *>(ts_cpp->data);
+    request_type_supports->typesupport_identifier =
+      rosidl_typesupport_introspection_cpp::typesupport_identifier;
+    request_type_supports->data = members->request_members_;
+    request_type_supports->func = get_message_typesupport_handle_function;
+    *response_type_supports = *request_type_supports;
+    response_type_supports->data = members->response_members_;
+    return;
+  }
+  /// @todo https://github.com/ros2/rosidl_typesupport/pull/102
+  rcutils_reset_error();
+
+  // second, try to extract c type support
+  auto ts_c = get_service_typesupport_handle(
+    type_supports, rosidl_typesupport_introspection_c__identifier);
+  if (ts_c != nullptr) {
+    auto members =
+      static_cast<const rosidl_typesupport_introspection_c__ServiceMembers *>(ts_c->data);
+    request_type_supports->typesupport_identifier = rosidl_typesupport_introspection_c__identifier;
+    request_type_supports->data = members->request_members_;
+    request_type_supports->func = get_message_typesupport_handle_function;
+    *response_type_supports = *request_type_supports;
+    response_type_supports->data = members->response_members_;
+    return;
+  }
+  rcutils_reset_error();
+
+  throw std::runtime_error("No suitable service type support given!");
+}
+
 }  // namespace rmw_iceoryx_cpp
@@ -12,13 +12,29 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <assert.h>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "iceoryx_posh/capro/service_description.hpp"
+#include "iceoryx_posh/iceoryx_posh_types.hpp"
+#include "iceoryx_posh/popo/untyped_publisher.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
 
 #include "rcutils/error_handling.h"
 
+#include "rmw/allocators.h"
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
+
+#include "./iceoryx_service_messages.hpp"
+#include "./types/iceoryx_client.hpp"
+#include "./types/iceoryx_wait_set.hpp"
+
 extern "C"
 {
 rmw_client_t *
@@ -28,13 +44,123 @@ rmw_create_client(
   const char * service_name,
   const rmw_qos_profile_t * qos_policies)
 {
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(node, NULL);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(type_supports, NULL);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(service_name, NULL);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(qos_policies, NULL);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(type_supports, nullptr);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(service_name, nullptr);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(qos_policies, nullptr);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_create_client
+    : node, node->implementation_identifier, rmw_get_implementation_identifier(), return nullptr);
+
+  rosidl_message_type_support_t request_type_supports;
+  rosidl_message_type_support_t response_type_supports;
+  try {
+    rmw_iceoryx_cpp::iceoryx_get_service_message_type_supports(
+      type_supports, &request_type_supports, &response_type_supports);
+  } catch (const std::runtime_error & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return nullptr;
+  }
+
+  auto request_service_description =
+    rmw_iceoryx_cpp::get_iceoryx_request_service_description(
+    service_name, &request_type_supports);
+
+  std::string node_full_name = std::string(node->namespace_) + std::string(node->name);
+  rmw_client_t * rmw_client = nullptr;
+  iox::popo::UntypedPublisher * iceoryx_sender = nullptr;
+  iox::popo::UntypedSubscriber * iceoryx_receiver = nullptr;
+  IceoryxClient * iceoryx_client = nullptr;
+
+  rmw_client = rmw_client_allocate();
+  if (!rmw_client) {
+    RMW_SET_ERROR_MSG("failed to allocate client");
+    goto fail;
+  }
+
+  iceoryx_sender =
+    static_cast<iox::popo::UntypedPublisher *>(rmw_allocate(
+      sizeof(iox::popo::UntypedPublisher)));
+  if (!iceoryx_sender) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for iceoryx sender");
+    goto fail;
+  }
+  RMW_TRY_PLACEMENT_NEW(
+    iceoryx_sender, iceoryx_sender, goto fail,
+    iox::popo::UntypedPublisher, request_service_description,
+    iox::popo::PublisherOptions{
+      0U, iox::NodeName_t(iox::cxx::TruncateToCapacity, node_full_name)});
+
+  iceoryx_sender->offer();
+
+  iceoryx_client =
+    static_cast<IceoryxClient *>(rmw_allocate(sizeof(IceoryxClient)));
+  if (!iceoryx_client) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for rmw iceoryx client");
+    goto fail;
+  }
+  RMW_TRY_PLACEMENT_NEW(
+    iceoryx_client, iceoryx_client, goto fail, IceoryxClient,
+    request_type_supports, response_type_supports, iceoryx_sender)
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support clients.");
-  return NULL;
+  iceoryx_receiver =
+    static_cast<iox::popo::UntypedSubscriber *>(rmw_allocate(
+      sizeof(iox::popo::UntypedSubscriber)));
+  if (!iceoryx_receiver) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for iceoryx receiver");
+    goto fail;
+  }
+  // the response topic is private to this client, responses sent before the service's publisher
+  // was matched are delivered from its history
+  RMW_TRY_PLACEMENT_NEW(
+    iceoryx_receiver, iceoryx_receiver, goto fail,
+    iox::popo::UntypedSubscriber,
+    rmw_iceoryx_cpp::get_iceoryx_response_service_description(
+      service_name, &response_type_supports, client_id_to_string(iceoryx_client->client_id_)),
+    iox::popo::SubscriberOptions{
+      qos_policies->depth,
+      std::min<uint64_t>(std::max<uint64_t>(qos_policies->depth, 1u), iox::MAX_PUBLISHER_HISTORY),
+      iox::NodeName_t(iox::cxx::TruncateToCapacity, node_full_name)});
+
+  iceoryx_receiver->subscribe();
+  iceoryx_client->iceoryx_receiver_ = iceoryx_receiver;
+
+  rmw_client->implementation_identifier = rmw_get_implementation_identifier();
+  rmw_client->data = iceoryx_client;
+  rmw_client->service_name =
+    static_cast<const char *>(rmw_allocate(sizeof(char) * strlen(service_name) + 1));
+  if (!rmw_client->service_name) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for client service name");
+    goto fail;
+  }
+  memcpy(const_cast<char *>(rmw_client->service_name), service_name, strlen(service_name) + 1);
+
+  return rmw_client;
+
+fail:
+  if (rmw_client) {
+    if (iceoryx_receiver) {
+      /// @todo Can we avoid to use the impl here?
+      RMW_TRY_DESTRUCTOR_FROM_WITHIN_FAILURE(
+        iceoryx_receiver->~UntypedSubscriberImpl(), iox::popo::UntypedSubscriber)
+      rmw_free(iceoryx_receiver);
+    }
+    if (iceoryx_client) {
+      RMW_TRY_DESTRUCTOR_FROM_WITHIN_FAILURE(
+        iceoryx_client->~IceoryxClient(), IceoryxClient)
+      rmw_free(iceoryx_client);
+    }
+    if (iceoryx_sender) {
+      /// @todo Can we avoid to use the impl here?
+      RMW_TRY_DESTRUCTOR_FROM_WITHIN_FAILURE(
+        iceoryx_sender->~UntypedPublisherImpl(), iox::popo::UntypedPublisher)
+      rmw_free(iceoryx_sender);
+    }
+    rmw_client_free(rmw_client);
+  }
+
+  return nullptr;
 }
 
 rmw_ret_t
@@ -45,7 +171,46 @@ rmw_destroy_client(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support clients.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_destroy_client
+    : client, client->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  rmw_ret_t result = RMW_RET_OK;
+
+  IceoryxClient * iceoryx_client = static_cast<IceoryxClient *>(client->data);
+  if (iceoryx_client) {
+    // the wait set holding the entity has to detach it before it is destroyed
+    take_from_wait_set(iceoryx_client);
+    if (iceoryx_client->iceoryx_receiver_) {
+      // @todo Can we avoid to use the impl here?
+      RMW_TRY_DESTRUCTOR(
+        iceoryx_client->iceoryx_receiver_->~UntypedSubscriberImpl(),
+        iceoryx_client->iceoryx_receiver_,
+        result = RMW_RET_ERROR)
+      rmw_free(iceoryx_client->iceoryx_receiver_);
+    }
+    if (iceoryx_client->iceoryx_sender_) {
+      // @todo Can we avoid to use the impl here?
+      RMW_TRY_DESTRUCTOR(
+        iceoryx_client->iceoryx_sender_->~UntypedPublisherImpl(),
+        iceoryx_client->iceoryx_sender_,
+        result = RMW_RET_ERROR)
+      rmw_free(iceoryx_client->iceoryx_sender_);
+    }
+    RMW_TRY_DESTRUCTOR(
+      iceoryx_client->~IceoryxClient(),
+      iceoryx_client,
+      result = RMW_RET_ERROR)
+    rmw_free(iceoryx_client);
+  }
+  client->data = nullptr;
+
+  rmw_free(const_cast<char *>(client->service_name));
+  client->service_name = nullptr;
+
+  rmw_client_free(client);
+
+  return result;
 }
 }  // extern "C"
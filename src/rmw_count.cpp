@@ -16,7 +16,7 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
-#include "rmw_iceoryx_cpp/iceoryx_topic_names_and_types.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
 
 extern "C"
 {
@@ -35,19 +35,7 @@ rmw_count_publishers(
     : node, node->implementation_identifier,
     rmw_get_implementation_identifier(), return RMW_RET_ERROR);
 
-  auto nodes_and_publishers = rmw_iceoryx_cpp::get_nodes_and_publishers();
-
-  size_t counter = 0;
-
-  for (auto node : nodes_and_publishers) {
-    for (auto topic : node.second) {
-      if (topic == topic_name) {
-        ++counter;
-      }
-    }
-  }
-
-  *count = counter;
+  *count = rmw_iceoryx_cpp::get_graph_cache().count_publishers(topic_name);
 
   return RMW_RET_OK;
 }
@@ -67,19 +55,7 @@ rmw_count_subscribers(
     : node, node->implementation_identifier,
     rmw_get_implementation_identifier(), return RMW_RET_ERROR);
 
-  auto nodes_and_subscribers = rmw_iceoryx_cpp::get_nodes_and_subscribers();
-
-  size_t counter = 0;
-
-  for (auto node : nodes_and_subscribers) {
-    for (auto topic : node.second) {
-      if (topic == topic_name) {
-        ++counter;
-      }
-    }
-  }
-
-  *count = counter;
+  *count = rmw_iceoryx_cpp::get_graph_cache().count_subscribers(topic_name);
 
   return RMW_RET_OK;
 }
@@ -97,19 +73,7 @@ rmw_subscription_count_matched_publishers(
     : subscription, subscription->implementation_identifier,
     rmw_get_implementation_identifier(), return RMW_RET_ERROR);
 
-  auto nodes_and_publishers = rmw_iceoryx_cpp::get_nodes_and_publishers();
-
-  size_t counter = 0;
-
-  for (auto node : nodes_and_publishers) {
-    for (auto topic : node.second) {
-      if (topic == subscription->topic_name) {
-        ++counter;
-      }
-    }
-  }
-
-  *publisher_count = counter;
+  *publisher_count = rmw_iceoryx_cpp::get_graph_cache().count_publishers(subscription->topic_name);
 
   return RMW_RET_OK;
 }
@@ -127,19 +91,7 @@ rmw_publisher_count_matched_subscriptions(
     : publisher, publisher->implementation_identifier,
     rmw_get_implementation_identifier(), return RMW_RET_ERROR);
 
-  auto nodes_and_subscribers = rmw_iceoryx_cpp::get_nodes_and_subscribers();
-
-  size_t counter = 0;
-
-  for (auto node : nodes_and_subscribers) {
-    for (auto topic : node.second) {
-      if (topic == publisher->topic_name) {
-        ++counter;
-      }
-    }
-  }
-
-  *subscription_count = counter;
+  *subscription_count = rmw_iceoryx_cpp::get_graph_cache().count_subscribers(publisher->topic_name);
   return RMW_RET_OK;
 }
 }  // extern "C"
@@ -41,9 +41,21 @@ rmw_subscription_event_init(
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(rmw_event, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
-  (void) event_type;
 
-  /// @todo add subscription events support
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_subscription_event_init
+    : subscription, subscription->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  /// @todo add the QoS events, the lost messages are detected from the sequence numbers
+  if (event_type != RMW_EVENT_MESSAGE_LOST) {
+    RMW_SET_ERROR_MSG("rmw_iceoryx_cpp only supports the message lost event");
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  rmw_event->implementation_identifier = subscription->implementation_identifier;
+  rmw_event->data = subscription->data;
+  rmw_event->event_type = event_type;
+  return RMW_RET_OK;
 }
 }  // extern "C"
@@ -18,8 +18,8 @@
 #include "rmw/rmw.h"
 #include "rmw/topic_endpoint_info_array.h"
 
-#include "rmw_iceoryx_cpp/iceoryx_topic_names_and_types.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_get_topic_endpoint_info.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
 
 extern "C" {
 rmw_ret_t rmw_get_publishers_info_by_topic(
@@ -42,12 +42,11 @@ rmw_ret_t rmw_get_publishers_info_by_topic(
     return rmw_ret;      // error already set
   }
 
-  auto iceoryx_publisher_endpoint_info =
-    rmw_iceoryx_cpp::get_publisher_end_info_of_topic(topic_name);
-
-  return rmw_iceoryx_cpp::fill_rmw_publisher_end_info(
-    publishers_info,
-    iceoryx_publisher_endpoint_info, allocator);
+  return rmw_iceoryx_cpp::get_graph_cache().read(
+    [&](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      return rmw_iceoryx_cpp::fill_rmw_end_info(
+        publishers_info, graph, topic_name, RMW_ENDPOINT_PUBLISHER, allocator);
+    });
 }
 
 rmw_ret_t rmw_get_subscriptions_info_by_topic(
@@ -70,11 +69,10 @@ rmw_ret_t rmw_get_subscriptions_info_by_topic(
     return rmw_ret;      // error already set
   }
 
-  auto iceoryx_subscriber_endpoint_info = rmw_iceoryx_cpp::get_subscriber_end_info_of_topic(
-    topic_name);
-
-  return rmw_iceoryx_cpp::fill_rmw_subscriber_end_info(
-    subscriptions_info, iceoryx_subscriber_endpoint_info,
-    allocator);
+  return rmw_iceoryx_cpp::get_graph_cache().read(
+    [&](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      return rmw_iceoryx_cpp::fill_rmw_end_info(
+        subscriptions_info, graph, topic_name, RMW_ENDPOINT_SUBSCRIPTION, allocator);
+    });
 }
 }  // extern "C"
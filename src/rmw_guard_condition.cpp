@@ -23,6 +23,9 @@
 #include "./iceoryx_identifier.hpp"
 #include "iceoryx_posh/popo/user_trigger.hpp"
 
+#include "./iceoryx_event_fd.hpp"
+#include "./types/iceoryx_wait_set.hpp"
+
 extern "C"
 {
 rmw_guard_condition_t *
@@ -94,6 +97,9 @@ rmw_destroy_guard_condition(rmw_guard_condition_t * guard_condition)
 
   auto result = RMW_RET_OK;
   if (iceoryx_guard_condition) {
+    // the wait set holding the entity has to detach it before it is destroyed
+    take_from_wait_set(iceoryx_guard_condition);
+    release_event_fd(iceoryx_guard_condition);
     RMW_TRY_DESTRUCTOR(
       iceoryx_guard_condition->~UserTrigger(),
       iceoryx_guard_condition,
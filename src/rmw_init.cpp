@@ -25,6 +25,8 @@
 #include "rmw/rmw.h"
 #include "rmw/types.h"
 
+#include "./types/iceoryx_context.hpp"
+
 extern "C"
 {
 rmw_ret_t
@@ -106,6 +108,16 @@ rmw_init(const rmw_init_options_t * options, rmw_context_t * context)
   iox::log::LogManager::GetLogManager().SetDefaultLogLevel(iox::log::LogLevel::kWarn);
   iox::runtime::PoshRuntime::initRuntime(iox::RuntimeName_t(iox::cxx::TruncateToCapacity, name));
 
+  context->impl = static_cast<rmw_context_impl_t *>(rmw_allocate(sizeof(rmw_context_impl_t)));
+  if (!context->impl) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for context impl");
+    return RMW_RET_BAD_ALLOC;
+  }
+  RMW_TRY_PLACEMENT_NEW(
+    context->impl, context->impl,
+    rmw_free(context->impl); context->impl = nullptr; return RMW_RET_ERROR,
+    rmw_context_impl_t)
+
   return RMW_RET_OK;
 }
 
@@ -133,8 +145,16 @@ rmw_context_fini(rmw_context_t * context)
     context->implementation_identifier,
     rmw_get_implementation_identifier(),
     return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
-  // context impl is explicitly supposed to be nullptr for now, see rmw_init()
+  rmw_ret_t result = RMW_RET_OK;
+  if (context->impl) {
+    // the nodes of the context are expected to be destroyed already
+    RMW_TRY_DESTRUCTOR(
+      context->impl->~rmw_context_impl_t(),
+      context->impl,
+      result = RMW_RET_ERROR)
+    rmw_free(context->impl);
+  }
   *context = rmw_get_zero_initialized_context();
-  return RMW_RET_OK;
+  return result;
 }
 }  // extern "C"
@@ -19,6 +19,7 @@
 
 #include "rmw/allocators.h"
 
+#include "./types/iceoryx_context.hpp"
 #include "./types/iceoryx_node.hpp"
 
 extern "C"
@@ -38,6 +39,7 @@ rmw_create_node(
     rmw_create_node
     : context, context->implementation_identifier,
     rmw_get_implementation_identifier(), return nullptr);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(context->impl, nullptr);
 
   std::string full_name = std::string(namespace_) + std::string(name);
   rmw_guard_condition_t * guard_condition = nullptr;
@@ -59,16 +61,12 @@ rmw_create_node(
     goto fail;
   }
 
-  /// @todo only use one GraphChangeNotifier for all nodes
-  graph_change_notifier =
-    static_cast<IceoryxGraphChangeNotifier *>(rmw_allocate(sizeof(IceoryxGraphChangeNotifier)));
-  if (!graph_change_notifier) {
-    RMW_SET_ERROR_MSG("failed to allocate memory for graph change notifier");
+  if (RMW_RET_OK !=
+    context->impl->graph_change_notifier_.register_guard_condition(guard_condition, full_name))
+  {
     goto fail;
   }
-  RMW_TRY_PLACEMENT_NEW(
-    graph_change_notifier, graph_change_notifier, goto fail,
-    IceoryxGraphChangeNotifier, guard_condition)
+  graph_change_notifier = &context->impl->graph_change_notifier_;
 
   // allocate iceoryx_runnable
   iceoryx_runnable =
@@ -114,9 +112,7 @@ rmw_create_node(
 fail:
   if (node_handle) {
     if (graph_change_notifier) {
-      RMW_TRY_DESTRUCTOR_FROM_WITHIN_FAILURE(
-        graph_change_notifier->~IceoryxGraphChangeNotifier(), IceoryxGraphChangeNotifier)
-      rmw_free(graph_change_notifier);
+      graph_change_notifier->unregister_guard_condition(guard_condition);
     }
     if (guard_condition) {
       if (RMW_RET_OK != rmw_destroy_guard_condition(guard_condition)) {
@@ -157,11 +153,7 @@ rmw_destroy_node(rmw_node_t * node)
   IceoryxNodeInfo * node_info = static_cast<IceoryxNodeInfo *>(node->data);
   if (node_info) {
     if (node_info->graph_change_notifier_) {
-      RMW_TRY_DESTRUCTOR(
-        node_info->graph_change_notifier_->~IceoryxGraphChangeNotifier(),
-        node_info->graph_change_notifier_,
-        result = RMW_RET_ERROR)
-      rmw_free(node_info->graph_change_notifier_);
+      node_info->graph_change_notifier_->unregister_guard_condition(node_info->guard_condition_);
     }
     if (RMW_RET_OK != rmw_destroy_guard_condition(node_info->guard_condition_)) {
       RMW_SET_ERROR_MSG("failed to delete graph guard condition");
@@ -13,15 +13,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <new>
 #include <vector>
 
 #include "iceoryx_posh/popo/untyped_publisher.hpp"
 
 #include "rcutils/error_handling.h"
+#include "rcutils/time.h"
 
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_flat_message.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_publisher_statistics.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_serialize.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
 
@@ -31,15 +35,51 @@
 #include "rosidl_typesupport_introspection_cpp/identifier.hpp"
 #include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
 
+#include "./iceoryx_user_header.hpp"
 #include "./types/iceoryx_publisher.hpp"
 
-extern "C"
-{
 namespace details
 {
+/// @brief Fills the user header of a loaned chunk right before it is published
+void stamp_user_header(IceoryxPublisher * iceoryx_publisher, void * user_payload)
+{
+  auto user_header = get_user_header(user_payload);
+  memcpy(user_header->publisher_gid, iceoryx_publisher->gid_.data, RMW_GID_STORAGE_SIZE);
+  rcutils_time_point_value_t now = 0;
+  (void) rcutils_system_time_now(&now);
+  user_header->source_timestamp = now;
+  user_header->sequence_number =
+    iceoryx_publisher->sequence_number_.fetch_add(1u, std::memory_order_relaxed) + 1u;
+}
+
+/// @brief Loans a chunk with an IceoryxUserHeader in front of the user payload
+template<typename OnLoanF>
+rmw_ret_t
+loan_chunk(IceoryxPublisher * iceoryx_publisher, size_t size, OnLoanF on_loan)
+{
+  rmw_ret_t ret = RMW_RET_ERROR;
+  iceoryx_publisher->iceoryx_sender_->loan(
+    static_cast<uint32_t>(size),
+    iox::CHUNK_DEFAULT_USER_PAYLOAD_ALIGNMENT,
+    sizeof(IceoryxUserHeader),
+    alignof(IceoryxUserHeader))
+  .and_then(
+    [&](void * userPayload) {
+      new (get_user_header(userPayload)) IceoryxUserHeader();
+      ret = on_loan(userPayload);
+    })
+  .or_else(
+    [&](iox::popo::AllocationError) {
+      iceoryx_publisher->failed_loans_.fetch_add(1u, std::memory_order_relaxed);
+      RMW_SET_ERROR_MSG("failed to loan a chunk");
+      ret = RMW_RET_ERROR;
+    });
+  return ret;
+}
+
 rmw_ret_t
 send_payload(
-  iox::popo::UntypedPublisher * iceoryx_publisher,
+  IceoryxPublisher * iceoryx_publisher,
   const void * serialized_ros_msg,
   size_t size)
 {
@@ -47,23 +87,30 @@ send_payload(
     RMW_SET_ERROR_MSG("serialized message pointer is null");
     return RMW_RET_ERROR;
   }
-  rmw_ret_t ret = RMW_RET_ERROR;
-  iceoryx_publisher->loan(size)
-  .and_then(
+  return loan_chunk(
+    iceoryx_publisher, size,
     [&](void * userPayload) {
       memcpy(userPayload, serialized_ros_msg, size);
-      iceoryx_publisher->publish(userPayload);
-      ret = RMW_RET_OK;
-    })
-  .or_else(
-    [&](iox::popo::AllocationError) {
-      RMW_SET_ERROR_MSG("send_payload error!");
-      ret = RMW_RET_ERROR;
+      stamp_user_header(iceoryx_publisher, userPayload);
+      iceoryx_publisher->iceoryx_sender_->publish(userPayload);
+      return RMW_RET_OK;
     });
-  return ret;
+}
+
+/// @brief Nobody would receive the message, so it is neither serialized nor copied into a chunk
+/// The publishers have no history, so late joining subscribers don't miss anything either.
+bool skip_publish(IceoryxPublisher * iceoryx_publisher)
+{
+  if (iceoryx_publisher->iceoryx_sender_->hasSubscribers()) {
+    return false;
+  }
+  iceoryx_publisher->skipped_publishes_.fetch_add(1u, std::memory_order_relaxed);
+  return true;
 }
 }  // namespace details
 
+extern "C"
+{
 rmw_ret_t
 rmw_publish(
   const rmw_publisher_t * publisher,
@@ -72,7 +119,6 @@ rmw_publish(
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_ERROR);
-  (void)allocation;
 
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
     rmw_publish
@@ -91,9 +137,13 @@ rmw_publish(
     return RMW_RET_ERROR;
   }
 
+  if (details::skip_publish(iceoryx_publisher)) {
+    return RMW_RET_OK;
+  }
+
   // if messages have a fixed size, we can just memcpy
   if (iceoryx_publisher->is_fixed_size_) {
-    return details::send_payload(iceoryx_sender, ros_message, iceoryx_publisher->message_size_);
+    return details::send_payload(iceoryx_publisher, ros_message, iceoryx_publisher->message_size_);
   }
 
   // this should never happen if checked already at rmw_create_publisher
@@ -103,12 +153,28 @@ rmw_publish(
   }
 
   // message is neither loaned nor fixed size, so we have to serialize
+  if (allocation) {
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+      rmw_publish
+      : allocation, allocation->implementation_identifier,
+      rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+    // reuse the preallocated buffer, clear() keeps its capacity
+    auto & payload_vector =
+      static_cast<IceoryxPublisherAllocation *>(allocation->data)->payload_vector_;
+    payload_vector.clear();
+
+    rmw_iceoryx_cpp::serialize(ros_message, &iceoryx_publisher->type_supports_, payload_vector);
+
+    return details::send_payload(iceoryx_publisher, payload_vector.data(), payload_vector.size());
+  }
+
   std::vector<char> payload_vector{};
 
   rmw_iceoryx_cpp::serialize(ros_message, &iceoryx_publisher->type_supports_, payload_vector);
 
   // send composed payload
-  return details::send_payload(iceoryx_sender, payload_vector.data(), payload_vector.size());
+  return details::send_payload(iceoryx_publisher, payload_vector.data(), payload_vector.size());
 }
 
 rmw_ret_t
@@ -138,9 +204,13 @@ rmw_publish_serialized_message(
     return RMW_RET_ERROR;
   }
 
+  if (details::skip_publish(iceoryx_publisher)) {
+    return RMW_RET_OK;
+  }
+
   // message is serialized, therefore necessarily fixed size
   return details::send_payload(
-    iceoryx_sender, serialized_message->buffer, serialized_message->buffer_length);
+    iceoryx_publisher, serialized_message->buffer, serialized_message->buffer_length);
 }
 
 rmw_ret_t
@@ -175,20 +245,32 @@ rmw_borrow_loaned_message(
     return RMW_RET_ERROR;
   }
 
-  rmw_ret_t ret = RMW_RET_ERROR;
-  iceoryx_sender->loan(iceoryx_publisher->message_size_)
-  .and_then(
+  if (iceoryx_publisher->is_flat_) {
+    return details::loan_chunk(
+      iceoryx_publisher, iceoryx_publisher->flat_message_size_,
+      [&](void * msg_memory) {
+        // the user header tells the subscribers that the chunk has to be read as flat message
+        get_user_header(msg_memory)->is_flat = true;
+        try {
+          rmw_iceoryx_cpp::iceoryx_init_flat_message(
+            &iceoryx_publisher->type_supports_, msg_memory);
+        } catch (const std::exception & e) {
+          iceoryx_sender->release(msg_memory);
+          RMW_SET_ERROR_MSG(e.what());
+          return RMW_RET_ERROR;
+        }
+        *ros_message = msg_memory;
+        return RMW_RET_OK;
+      });
+  }
+
+  return details::loan_chunk(
+    iceoryx_publisher, iceoryx_publisher->message_size_,
     [&](void * msg_memory) {
       rmw_iceoryx_cpp::iceoryx_init_message(&iceoryx_publisher->type_supports_, msg_memory);
       *ros_message = msg_memory;
-      ret = RMW_RET_OK;
-    })
-  .or_else(
-    [&](iox::popo::AllocationError) {
-      RMW_SET_ERROR_MSG("rmw_borrow_loaned_message error!");
-      ret = RMW_RET_ERROR;
+      return RMW_RET_OK;
     });
-  return ret;
 }
 
 rmw_ret_t
@@ -220,7 +302,10 @@ rmw_return_loaned_message_from_publisher(const rmw_publisher_t * publisher, void
     return RMW_RET_ERROR;
   }
 
-  rmw_iceoryx_cpp::iceoryx_fini_message(&iceoryx_publisher->type_supports_, loaned_message);
+  // the storage of flat messages is part of the chunk
+  if (!iceoryx_publisher->is_flat_) {
+    rmw_iceoryx_cpp::iceoryx_fini_message(&iceoryx_publisher->type_supports_, loaned_message);
+  }
   iceoryx_sender->release(loaned_message);
 
   return RMW_RET_OK;
@@ -253,11 +338,67 @@ rmw_publish_loaned_message(
     return RMW_RET_ERROR;
   }
 
-  if (!iceoryx_publisher->is_fixed_size_) {
-    RMW_SET_ERROR_MSG("iceoryx can't loan non-fixed sized messages");
+  if (iceoryx_publisher->is_flat_) {
+    // pointers into the chunk are only valid in this process
+    try {
+      rmw_iceoryx_cpp::iceoryx_relocate_flat_message(
+        &iceoryx_publisher->type_supports_, ros_message);
+    } catch (const std::exception & e) {
+      iceoryx_sender->release(ros_message);
+      RMW_SET_ERROR_MSG(e.what());
+      return RMW_RET_ERROR;
+    }
+  } else if (!iceoryx_publisher->is_fixed_size_) {
+    RMW_SET_ERROR_MSG("iceoryx can't loan unbounded messages");
     return RMW_RET_ERROR;
   }
+  details::stamp_user_header(iceoryx_publisher, ros_message);
   iceoryx_sender->publish(ros_message);
   return RMW_RET_OK;
 }
 }  // extern "C"
+
+namespace rmw_iceoryx_cpp
+{
+rmw_ret_t
+get_skipped_publish_count(const rmw_publisher_t * publisher, uint64_t * count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    get_skipped_publish_count
+    : publisher, publisher->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_publisher = static_cast<IceoryxPublisher *>(publisher->data);
+  if (!iceoryx_publisher) {
+    RMW_SET_ERROR_MSG("publisher data is null");
+    return RMW_RET_ERROR;
+  }
+
+  *count = iceoryx_publisher->skipped_publishes_.load(std::memory_order_relaxed);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+get_failed_loan_count(const rmw_publisher_t * publisher, uint64_t * count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(count, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    get_failed_loan_count
+    : publisher, publisher->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_publisher = static_cast<IceoryxPublisher *>(publisher->data);
+  if (!iceoryx_publisher) {
+    RMW_SET_ERROR_MSG("publisher data is null");
+    return RMW_RET_ERROR;
+  }
+
+  *count = iceoryx_publisher->failed_loans_.load(std::memory_order_relaxed);
+  return RMW_RET_OK;
+}
+}  // namespace rmw_iceoryx_cpp
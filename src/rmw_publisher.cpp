@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <new>
 #include <string>
 
 #include "iceoryx_posh/capro/service_description.hpp"
@@ -23,6 +24,8 @@
 #include "rmw/impl/cpp/macros.hpp"
 
 #include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_serialize.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
 
 #include "./types/iceoryx_publisher.hpp"
 
@@ -38,8 +41,41 @@ rmw_init_publisher_allocation(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_bounds, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support publisher allocations.");
-  return RMW_RET_UNSUPPORTED;
+  if (!rmw_iceoryx_cpp::iceoryx_is_valid_type_support(type_support)) {
+    RMW_SET_ERROR_MSG("Use either C typesupport or CPP typesupport");
+    return RMW_RET_ERROR;
+  }
+
+  // rosidl_runtime_c__Sequence__bound only holds a type support and no bound values, so the
+  // bounds are taken from the type. For unbounded types the buffer grows to the largest message
+  // published and is kept.
+  size_t buffer_size = rmw_iceoryx_cpp::get_serialized_size_upper_bound(type_support);
+  if (buffer_size == 0u) {
+    buffer_size = rmw_iceoryx_cpp::iceoryx_get_message_size(type_support);
+  }
+
+  IceoryxPublisherAllocation * publisher_allocation = static_cast<IceoryxPublisherAllocation *>(
+    rmw_allocate(sizeof(IceoryxPublisherAllocation)));
+  if (!publisher_allocation) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for publisher allocation");
+    return RMW_RET_BAD_ALLOC;
+  }
+  RMW_TRY_PLACEMENT_NEW(
+    publisher_allocation, publisher_allocation,
+    rmw_free(publisher_allocation); return RMW_RET_BAD_ALLOC,
+    IceoryxPublisherAllocation)
+  try {
+    publisher_allocation->payload_vector_.reserve(buffer_size);
+  } catch (const std::bad_alloc &) {
+    publisher_allocation->~IceoryxPublisherAllocation();
+    rmw_free(publisher_allocation);
+    RMW_SET_ERROR_MSG("failed to reserve the serialization buffer");
+    return RMW_RET_BAD_ALLOC;
+  }
+
+  allocation->implementation_identifier = rmw_get_implementation_identifier();
+  allocation->data = publisher_allocation;
+  return RMW_RET_OK;
 }
 
 rmw_ret_t
@@ -47,8 +83,23 @@ rmw_fini_publisher_allocation(rmw_publisher_allocation_t * allocation)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support publisher allocations.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_fini_publisher_allocation
+    : allocation, allocation->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  rmw_ret_t result = RMW_RET_OK;
+  auto publisher_allocation = static_cast<IceoryxPublisherAllocation *>(allocation->data);
+  if (publisher_allocation) {
+    RMW_TRY_DESTRUCTOR(
+      publisher_allocation->~IceoryxPublisherAllocation(),
+      publisher_allocation,
+      result = RMW_RET_ERROR)
+    rmw_free(publisher_allocation);
+  }
+  allocation->implementation_identifier = nullptr;
+  allocation->data = nullptr;
+  return result;
 }
 
 rmw_publisher_t *
@@ -123,7 +174,8 @@ rmw_create_publisher(
     goto fail;
   }
   memcpy(const_cast<char *>(rmw_publisher->topic_name), topic_name, strlen(topic_name) + 1);
-  rmw_publisher->can_loan_messages = iceoryx_publisher->is_fixed_size_;
+  rmw_publisher->can_loan_messages =
+    iceoryx_publisher->is_fixed_size_ || iceoryx_publisher->is_flat_;
 
   return rmw_publisher;
 
@@ -17,9 +17,12 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "./iceoryx_service_messages.hpp"
+#include "./types/iceoryx_client.hpp"
+#include "./types/iceoryx_service.hpp"
+
 extern "C"
 {
-/// @todo Use the new request/response API of iceoryx v2.0 here
 rmw_ret_t
 rmw_send_request(
   const rmw_client_t * client,
@@ -28,13 +31,31 @@ rmw_send_request(
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_request, RMW_RET_ERROR);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sequence_id, RMW_RET_ERROR);  // can be null?
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(sequence_id, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_send_request
+    : client, client->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_client = static_cast<IceoryxClient *>(client->data);
+  if (!iceoryx_client) {
+    RMW_SET_ERROR_MSG("client data is null");
+    return RMW_RET_ERROR;
+  }
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support requests.");
-  return RMW_RET_UNSUPPORTED;
+  // the service sends the response to the client id with this sequence number
+  int64_t sequence_number =
+    iceoryx_client->sequence_number_.fetch_add(1, std::memory_order_relaxed) + 1;
+  rmw_ret_t ret = send_service_message(
+    iceoryx_client->iceoryx_sender_, iceoryx_client->request_type_, ros_request,
+    iceoryx_client->client_id_, sequence_number);
+  if (ret == RMW_RET_OK) {
+    *sequence_id = sequence_number;
+  }
+  return ret;
 }
 
-/// @todo Use the new request/response API of iceoryx v2.0 here
 rmw_ret_t
 rmw_take_request(
   const rmw_service_t * service,
@@ -47,7 +68,26 @@ rmw_take_request(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_request, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support requests.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_take_request
+    : service, service->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_service = static_cast<IceoryxService *>(service->data);
+  if (!iceoryx_service) {
+    RMW_SET_ERROR_MSG("service data is null");
+    return RMW_RET_ERROR;
+  }
+
+  rmw_ret_t ret = take_service_message(
+    iceoryx_service->iceoryx_receiver_, iceoryx_service->request_type_, ros_request,
+    request_header, taken);
+  if (ret == RMW_RET_OK && *taken) {
+    // the response publisher of a new client is offered while the request is processed, so the
+    // subscriber of the client is likely connected when the response is sent. If this fails,
+    // rmw_send_response tries again and reports the error.
+    get_response_sender(iceoryx_service, request_header->request_id.writer_guid);
+  }
+  return ret;
 }
 }  // extern "C"
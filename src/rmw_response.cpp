@@ -17,11 +17,13 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "./iceoryx_service_messages.hpp"
+#include "./types/iceoryx_client.hpp"
+#include "./types/iceoryx_service.hpp"
+
 extern "C"
 {
 rmw_ret_t
-
-/// @todo Use the new request/response API of iceoryx v2.0 here
 rmw_take_response(
   const rmw_client_t * client,
   rmw_service_info_t * request_header,
@@ -33,11 +35,23 @@ rmw_take_response(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support responses.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_take_response
+    : client, client->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_client = static_cast<IceoryxClient *>(client->data);
+  if (!iceoryx_client) {
+    RMW_SET_ERROR_MSG("client data is null");
+    return RMW_RET_ERROR;
+  }
+
+  // the response topic is private to the client, so all responses are meant for it
+  return take_service_message(
+    iceoryx_client->iceoryx_receiver_, iceoryx_client->response_type_, ros_response,
+    request_header, taken);
 }
 
-/// @todo Use the new request/response API of iceoryx v2.0 here
 rmw_ret_t
 rmw_send_response(
   const rmw_service_t * service,
@@ -48,7 +62,25 @@ rmw_send_response(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(request_header, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support responses.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_send_response
+    : service, service->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_service = static_cast<IceoryxService *>(service->data);
+  if (!iceoryx_service) {
+    RMW_SET_ERROR_MSG("service data is null");
+    return RMW_RET_ERROR;
+  }
+
+  auto response_sender = get_response_sender(iceoryx_service, request_header->writer_guid);
+  if (!response_sender) {
+    RMW_SET_ERROR_MSG("failed to create the response publisher");
+    return RMW_RET_BAD_ALLOC;
+  }
+
+  return send_service_message(
+    response_sender, iceoryx_service->response_type_, ros_response,
+    request_header->writer_guid, request_header->sequence_number);
 }
 }  // extern "C"
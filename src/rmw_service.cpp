@@ -12,15 +12,29 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "iceoryx_posh/capro/service_description.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+
 #include "rcutils/error_handling.h"
 
 #include "rmw/allocators.h"
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
+
+#include "./types/iceoryx_service.hpp"
+#include "./types/iceoryx_wait_set.hpp"
+
 extern "C"
 {
-/// @todo Use the new request/response API of iceoryx v2.0 here instead of dummy services
 rmw_service_t *
 rmw_create_service(
   const rmw_node_t * node,
@@ -33,28 +47,92 @@ rmw_create_service(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(service_name, nullptr);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(qos_policies, nullptr);
 
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_create_service
+    : node, node->implementation_identifier, rmw_get_implementation_identifier(), return nullptr);
+
+  rosidl_message_type_support_t request_type_supports;
+  rosidl_message_type_support_t response_type_supports;
+  try {
+    rmw_iceoryx_cpp::iceoryx_get_service_message_type_supports(
+      type_supports, &request_type_supports, &response_type_supports);
+  } catch (const std::runtime_error & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return nullptr;
+  }
+
+  // the requests of all clients are received on a single topic
+  auto service_description =
+    rmw_iceoryx_cpp::get_iceoryx_request_service_description(
+    service_name, &request_type_supports);
+
+  std::string node_full_name = std::string(node->namespace_) + std::string(node->name);
   rmw_service_t * rmw_service = nullptr;
+  iox::popo::UntypedSubscriber * iceoryx_receiver = nullptr;
+  IceoryxService * iceoryx_service = nullptr;
 
   rmw_service = rmw_service_allocate();
   if (!rmw_service) {
     RMW_SET_ERROR_MSG("failed to allocate memory for service");
-    return nullptr;
+    goto fail;
   }
 
-  void * info = nullptr;
+  iceoryx_receiver =
+    static_cast<iox::popo::UntypedSubscriber *>(rmw_allocate(
+      sizeof(iox::popo::UntypedSubscriber)));
+  if (!iceoryx_receiver) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for iceoryx receiver");
+    goto fail;
+  }
+  RMW_TRY_PLACEMENT_NEW(
+    iceoryx_receiver, iceoryx_receiver, goto fail,
+    iox::popo::UntypedSubscriber, service_description,
+    iox::popo::SubscriberOptions{
+      qos_policies->depth, 0U, iox::NodeName_t(iox::cxx::TruncateToCapacity, node_full_name)});
 
-  rmw_service->implementation_identifier = rmw_get_implementation_identifier();
-  rmw_service->data = info;
+  iceoryx_receiver->subscribe();
 
+  iceoryx_service =
+    static_cast<IceoryxService *>(rmw_allocate(sizeof(IceoryxService)));
+  if (!iceoryx_service) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for rmw iceoryx service");
+    goto fail;
+  }
+  RMW_TRY_PLACEMENT_NEW(
+    iceoryx_service, iceoryx_service, goto fail, IceoryxService,
+    request_type_supports, response_type_supports, iceoryx_receiver, service_name,
+    node_full_name,
+    std::min<uint64_t>(std::max<uint64_t>(qos_policies->depth, 1u), iox::MAX_PUBLISHER_HISTORY))
+
+  rmw_service->implementation_identifier = rmw_get_implementation_identifier();
+  rmw_service->data = iceoryx_service;
   rmw_service->service_name =
     static_cast<const char *>(rmw_allocate(sizeof(char) * strlen(service_name) + 1));
   if (!rmw_service->service_name) {
-    RMW_SET_ERROR_MSG("failed to allocate memory for publisher topic name");
-  } else {
-    memcpy(const_cast<char *>(rmw_service->service_name), service_name, strlen(service_name) + 1);
+    RMW_SET_ERROR_MSG("failed to allocate memory for service name");
+    goto fail;
   }
+  memcpy(const_cast<char *>(rmw_service->service_name), service_name, strlen(service_name) + 1);
 
   return rmw_service;
+
+fail:
+  if (rmw_service) {
+    if (iceoryx_service) {
+      RMW_TRY_DESTRUCTOR_FROM_WITHIN_FAILURE(
+        iceoryx_service->~IceoryxService(), IceoryxService)
+      rmw_free(iceoryx_service);
+    }
+    if (iceoryx_receiver) {
+      /// @todo Can we avoid to use the impl here?
+      RMW_TRY_DESTRUCTOR_FROM_WITHIN_FAILURE(
+        iceoryx_receiver->~UntypedSubscriberImpl(), iox::popo::UntypedSubscriber)
+      rmw_free(iceoryx_receiver);
+    }
+    rmw_service_free(rmw_service);
+  }
+
+  return nullptr;
 }
 
 rmw_ret_t
@@ -70,6 +148,27 @@ rmw_destroy_service(rmw_node_t * node, rmw_service_t * service)
 
   rmw_ret_t result = RMW_RET_OK;
 
+  IceoryxService * iceoryx_service = static_cast<IceoryxService *>(service->data);
+  if (iceoryx_service) {
+    // the wait set holding the entity has to detach it before it is destroyed
+    take_from_wait_set(iceoryx_service);
+    if (iceoryx_service->iceoryx_receiver_) {
+      // @todo Can we avoid to use the impl here?
+      RMW_TRY_DESTRUCTOR(
+        iceoryx_service->iceoryx_receiver_->~UntypedSubscriberImpl(),
+        iceoryx_service->iceoryx_receiver_,
+        result = RMW_RET_ERROR)
+      rmw_free(iceoryx_service->iceoryx_receiver_);
+    }
+    // the response publishers are owned by the service
+    RMW_TRY_DESTRUCTOR(
+      iceoryx_service->~IceoryxService(),
+      iceoryx_service,
+      result = RMW_RET_ERROR)
+    rmw_free(iceoryx_service);
+  }
+  service->data = nullptr;
+
   rmw_free(const_cast<char *>(service->service_name));
   service->service_name = nullptr;
 
@@ -19,6 +19,9 @@
 #include "rmw/names_and_types.h"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_topic_names_and_types.hpp"
+
 extern "C"
 {
 rmw_ret_t
@@ -31,7 +34,21 @@ rmw_get_service_names_and_types(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocator, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(service_names_and_types, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support services.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_get_service_names_and_types
+    : node, node->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  rmw_ret_t rmw_ret = rmw_names_and_types_check_zero(service_names_and_types);
+  if (rmw_ret != RMW_RET_OK) {
+    return rmw_ret;  // error already set
+  }
+
+  // the services are derived from their request topics
+  return rmw_iceoryx_cpp::get_graph_cache().read(
+    [&](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      return rmw_iceoryx_cpp::fill_rmw_service_names_and_types(
+        service_names_and_types, graph, allocator);
+    });
 }
 }  // extern "C"
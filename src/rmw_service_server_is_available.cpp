@@ -17,6 +17,8 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "./types/iceoryx_client.hpp"
+
 extern "C"
 {
 rmw_ret_t
@@ -29,7 +31,19 @@ rmw_service_server_is_available(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(is_available, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support services.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_service_server_is_available
+    : client, client->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_client = static_cast<IceoryxClient *>(client->data);
+  if (!iceoryx_client) {
+    RMW_SET_ERROR_MSG("client data is null");
+    return RMW_RET_ERROR;
+  }
+
+  // a service subscribes to the request topic as long as it exists
+  *is_available = iceoryx_client->iceoryx_sender_->hasSubscribers();
+  return RMW_RET_OK;
 }
 }  // extern "C"
@@ -13,19 +13,40 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <new>
 #include <string>
 
 #include "iceoryx_posh/capro/service_description.hpp"
 
 #include "rcutils/error_handling.h"
+#include "rcutils/get_env.h"
 
 #include "rmw/allocators.h"
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_deserialize.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_latency_histogram.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_name_conversion.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_serialize.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
 
+#include "./iceoryx_event_fd.hpp"
 #include "./types/iceoryx_subscription.hpp"
+#include "./types/iceoryx_wait_set.hpp"
+
+namespace details
+{
+/// @brief Read at each subscription creation, so it can be switched for single subscriptions
+bool latency_statistics_enabled()
+{
+  const char * value = nullptr;
+  if (rcutils_get_env(rmw_iceoryx_cpp::LATENCY_STATISTICS_ENV_VAR, &value) != nullptr) {
+    return false;
+  }
+  return value != nullptr && std::string(value) == "1";
+}
+}  // namespace details
 
 extern "C"
 {
@@ -37,10 +58,47 @@ rmw_init_subscription_allocation(
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(type_supports, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_bounds, RMW_RET_ERROR);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_ERROR);  // might be null
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_ERROR);
+
+  if (!rmw_iceoryx_cpp::iceoryx_is_valid_type_support(type_supports)) {
+    RMW_SET_ERROR_MSG("Use either C typesupport or CPP typesupport");
+    return RMW_RET_ERROR;
+  }
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support subscription allocations.");
-  return RMW_RET_UNSUPPORTED;
+  // rosidl_runtime_c__Sequence__bound only holds a type support and no bound values, so the
+  // bounds are taken from the type. The type is walked once here, rmw_take presizes the message
+  // with the resulting plan, see rmw_iceoryx_cpp::reserve_message.
+  IceoryxSubscriptionAllocation * subscription_allocation =
+    static_cast<IceoryxSubscriptionAllocation *>(
+    rmw_allocate(sizeof(IceoryxSubscriptionAllocation)));
+  if (!subscription_allocation) {
+    RMW_SET_ERROR_MSG("failed to allocate memory for subscription allocation");
+    return RMW_RET_BAD_ALLOC;
+  }
+  RMW_TRY_PLACEMENT_NEW(
+    subscription_allocation, subscription_allocation,
+    rmw_free(subscription_allocation); return RMW_RET_BAD_ALLOC,
+    IceoryxSubscriptionAllocation)
+
+  // flat messages need a conversion buffer, they are bounded. A C++ subscriber receives them from
+  // C publishers of the same type, so the buffer doesn't depend on the language of the type support
+  const size_t serialized_size_upper_bound =
+    rmw_iceoryx_cpp::get_serialized_size_upper_bound(type_supports);
+  try {
+    if (serialized_size_upper_bound > 0u) {
+      subscription_allocation->payload_vector_.reserve(serialized_size_upper_bound);
+    }
+    subscription_allocation->reserve_plan_ = rmw_iceoryx_cpp::get_reserve_plan(type_supports);
+  } catch (const std::bad_alloc &) {
+    subscription_allocation->~IceoryxSubscriptionAllocation();
+    rmw_free(subscription_allocation);
+    RMW_SET_ERROR_MSG("failed to reserve the conversion buffer");
+    return RMW_RET_BAD_ALLOC;
+  }
+
+  allocation->implementation_identifier = rmw_get_implementation_identifier();
+  allocation->data = subscription_allocation;
+  return RMW_RET_OK;
 }
 
 rmw_ret_t
@@ -48,8 +106,23 @@ rmw_fini_subscription_allocation(rmw_subscription_allocation_t * allocation)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support subscription allocations.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_fini_subscription_allocation
+    : allocation, allocation->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  rmw_ret_t result = RMW_RET_OK;
+  auto subscription_allocation = static_cast<IceoryxSubscriptionAllocation *>(allocation->data);
+  if (subscription_allocation) {
+    RMW_TRY_DESTRUCTOR(
+      subscription_allocation->~IceoryxSubscriptionAllocation(),
+      subscription_allocation,
+      result = RMW_RET_ERROR)
+    rmw_free(subscription_allocation);
+  }
+  allocation->implementation_identifier = nullptr;
+  allocation->data = nullptr;
+  return result;
 }
 
 rmw_subscription_t *
@@ -123,6 +196,15 @@ rmw_create_subscription(
 
   rmw_subscription->can_loan_messages = iceoryx_subscription->is_fixed_size_;
 
+  if (details::latency_statistics_enabled()) {
+    iceoryx_subscription->latency_histogram_.reset(
+      new (std::nothrow) rmw_iceoryx_cpp::LatencyHistogram());
+    if (!iceoryx_subscription->latency_histogram_) {
+      RMW_SET_ERROR_MSG("failed to allocate latency histogram");
+      goto fail;
+    }
+  }
+
   return rmw_subscription;
 
 fail:
@@ -179,7 +261,10 @@ rmw_destroy_subscription(
   IceoryxSubscription * iceoryx_subscription =
     static_cast<IceoryxSubscription *>(subscription->data);
   if (iceoryx_subscription) {
+    // the wait set holding the entity has to detach it before it is destroyed
+    take_from_wait_set(iceoryx_subscription);
     if (iceoryx_subscription->iceoryx_receiver_) {
+      release_event_fd(iceoryx_subscription);
       // @todo Can we avoid to use the impl here?
       RMW_TRY_DESTRUCTOR(
         iceoryx_subscription->iceoryx_receiver_->~UntypedSubscriberImpl(),
@@ -203,3 +288,59 @@ rmw_destroy_subscription(
   return result;
 }
 }  // extern "C"
+
+namespace rmw_iceoryx_cpp
+{
+rmw_ret_t
+get_latency_histogram(
+  const rmw_subscription_t * subscription,
+  LatencyHistogram::Snapshot * snapshot)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(snapshot, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    get_latency_histogram
+    : subscription, subscription->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_subscription = static_cast<IceoryxSubscription *>(subscription->data);
+  if (!iceoryx_subscription) {
+    RMW_SET_ERROR_MSG("subscription data is null");
+    return RMW_RET_ERROR;
+  }
+
+  if (!iceoryx_subscription->latency_histogram_) {
+    RMW_SET_ERROR_MSG("latency statistics are not enabled for this subscription");
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  *snapshot = iceoryx_subscription->latency_histogram_->snapshot();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+reset_latency_histogram(const rmw_subscription_t * subscription)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    reset_latency_histogram
+    : subscription, subscription->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_subscription = static_cast<IceoryxSubscription *>(subscription->data);
+  if (!iceoryx_subscription) {
+    RMW_SET_ERROR_MSG("subscription data is null");
+    return RMW_RET_ERROR;
+  }
+
+  if (!iceoryx_subscription->latency_histogram_) {
+    RMW_SET_ERROR_MSG("latency statistics are not enabled for this subscription");
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  iceoryx_subscription->latency_histogram_->reset();
+  return RMW_RET_OK;
+}
+}  // namespace rmw_iceoryx_cpp
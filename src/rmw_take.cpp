@@ -13,11 +13,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
+#include <vector>
+
+#include "./iceoryx_user_header.hpp"
 #include "./types/iceoryx_subscription.hpp"
 
+#include "iceoryx_posh/iceoryx_posh_types.hpp"
 #include "iceoryx_posh/popo/untyped_subscriber.hpp"
 
 #include "rcutils/error_handling.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/time.h"
 
 #include "rmw/event.h"
 #include "rmw/impl/cpp/macros.hpp"
@@ -26,6 +33,8 @@
 
 #include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_deserialize.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_flat_message.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_message_view.hpp"
 
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
 #include "rosidl_typesupport_introspection_c/identifier.h"
@@ -35,17 +44,135 @@
 
 extern "C"
 {
+namespace details
+{
+/// rmw_take_sequence warns at most this often about messages taken before a failure
+constexpr int64_t PARTIAL_TAKE_WARNING_PERIOD_MS = 1000;
+
+/// @brief Fills ros_message from a taken chunk, the chunk is not released
 rmw_ret_t
-rmw_take(
+deserialize_chunk(
+  IceoryxSubscription * iceoryx_subscription,
+  IceoryxSubscriptionAllocation * subscription_allocation,
+  const void * user_payload,
+  void * ros_message)
+{
+  auto chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(user_payload);
+
+  // if fixed size, we fetch the data via memcpy
+  if (iceoryx_subscription->is_fixed_size_) {
+    memcpy(ros_message, user_payload, chunk_header->userPayloadSize());
+    return RMW_RET_OK;
+  }
+
+  try {
+    // a presized message is deserialized without touching the heap, the plan only visits the
+    // bounded fields and reserves those below their bound
+    if (subscription_allocation) {
+      rmw_iceoryx_cpp::reserve_message(subscription_allocation->reserve_plan_, ros_message);
+    }
+
+    if (get_payload_layout(user_payload, false) == rmw_iceoryx_cpp::PayloadLayout::FLAT) {
+      // flat messages contain offsets into the chunk which are resolved via the serialized format
+      std::vector<char> local_payload_vector{};
+      auto & payload_vector = subscription_allocation ?
+        subscription_allocation->payload_vector_ : local_payload_vector;
+      payload_vector.clear();
+      rmw_iceoryx_cpp::iceoryx_flat_to_serialized(
+        user_payload, chunk_header->userPayloadSize(),
+        &iceoryx_subscription->type_supports_, payload_vector);
+      rmw_iceoryx_cpp::deserialize(
+        payload_vector.data(), &iceoryx_subscription->type_supports_, ros_message);
+    } else {
+      rmw_iceoryx_cpp::deserialize(
+        static_cast<const char *>(user_payload),
+        &iceoryx_subscription->type_supports_,
+        ros_message);
+    }
+  } catch (const std::exception & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return RMW_RET_ERROR;
+  }
+  return RMW_RET_OK;
+}
+
+/// @brief Records the publish-to-take latency of a taken chunk if the statistics are enabled
+inline void
+record_latency(IceoryxSubscription * iceoryx_subscription, const void * user_payload)
+{
+  if (!iceoryx_subscription->latency_histogram_) {
+    return;
+  }
+  auto user_header = get_user_header(user_payload);
+  if (!user_header) {
+    return;
+  }
+  rcutils_time_point_value_t now = 0;
+  (void) rcutils_system_time_now(&now);
+  iceoryx_subscription->latency_histogram_->record(now - user_header->source_timestamp);
+}
+
+/// @brief Counts the messages lost since the last chunk of the same publisher
+inline void
+record_sequence_number(IceoryxSubscription * iceoryx_subscription, const void * user_payload)
+{
+  auto user_header = get_user_header(user_payload);
+  if (!user_header || user_header->sequence_number == 0u) {
+    return;
+  }
+  const uint64_t lost = record_publisher_sequence(
+    iceoryx_subscription->publisher_sequences_, user_header->publisher_gid,
+    user_header->sequence_number);
+  if (lost > 0u) {
+    iceoryx_subscription->lost_message_count_.fetch_add(lost, std::memory_order_relaxed);
+  }
+}
+
+/// @brief Bookkeeping for every chunk taken from the iceoryx subscriber
+inline void
+on_chunk_taken(IceoryxSubscription * iceoryx_subscription, const void * user_payload)
+{
+  record_latency(iceoryx_subscription, user_payload);
+  record_sequence_number(iceoryx_subscription, user_payload);
+}
+
+/// @brief Fills message_info from the user header of a taken chunk
+void
+fill_message_info(
+  IceoryxSubscription * iceoryx_subscription,
+  const void * user_payload,
+  rmw_message_info_t * message_info)
+{
+  *message_info = rmw_get_zero_initialized_message_info();
+
+  rcutils_time_point_value_t now = 0;
+  (void) rcutils_system_time_now(&now);
+  message_info->received_timestamp = now;
+  message_info->reception_sequence_number = ++iceoryx_subscription->reception_sequence_number_;
+  message_info->publisher_gid.implementation_identifier = rmw_get_implementation_identifier();
+  message_info->from_intra_process = false;
+
+  auto user_header = get_user_header(user_payload);
+  if (!user_header) {
+    message_info->publication_sequence_number = RMW_MESSAGE_INFO_SEQUENCE_NUMBER_UNSUPPORTED;
+    return;
+  }
+  memcpy(message_info->publisher_gid.data, user_header->publisher_gid, RMW_GID_STORAGE_SIZE);
+  message_info->source_timestamp = user_header->source_timestamp;
+  message_info->publication_sequence_number = user_header->sequence_number;
+}
+
+rmw_ret_t
+take_message(
   const rmw_subscription_t * subscription,
   void * ros_message,
   bool * taken,
+  rmw_message_info_t * message_info,
   rmw_subscription_allocation_t * allocation)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
-  (void)allocation;
 
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
     rmw_take
@@ -54,6 +181,15 @@ rmw_take(
     rmw_get_implementation_identifier(),
     return RMW_RET_ERROR);
 
+  IceoryxSubscriptionAllocation * subscription_allocation = nullptr;
+  if (allocation) {
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+      rmw_take
+      : allocation, allocation->implementation_identifier,
+      rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+    subscription_allocation = static_cast<IceoryxSubscriptionAllocation *>(allocation->data);
+  }
+
   auto iceoryx_subscription = static_cast<IceoryxSubscription *>(subscription->data);
   if (!iceoryx_subscription) {
     RMW_SET_ERROR_MSG("subscription data is null");
@@ -77,15 +213,14 @@ rmw_take(
     return RMW_RET_ERROR;
   }
 
-  const iox::mepoo::ChunkHeader * chunk_header = nullptr;
   const void * user_payload = nullptr;
 
   rmw_ret_t ret = RMW_RET_ERROR;
   iceoryx_receiver->take()
   .and_then(
     [&](const void * userPayload) {
+      on_chunk_taken(iceoryx_subscription, userPayload);
       user_payload = userPayload;
-      chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(user_payload);
       ret = RMW_RET_OK;
     })
   .or_else(
@@ -99,24 +234,27 @@ rmw_take(
     return ret;
   }
 
-  // if fixed size, we fetch the data via memcpy
-  if (iceoryx_subscription->is_fixed_size_) {
-    memcpy(ros_message, user_payload, chunk_header->userPayloadSize());
-    iceoryx_receiver->release(user_payload);
-    *taken = true;
-    ret = RMW_RET_OK;
-  } else {
-    rmw_iceoryx_cpp::deserialize(
-      static_cast<const char *>(user_payload),
-      &iceoryx_subscription->type_supports_,
-      ros_message);
-    iceoryx_receiver->release(user_payload);
-    *taken = true;
-    ret = RMW_RET_OK;
+  ret = deserialize_chunk(
+    iceoryx_subscription, subscription_allocation, user_payload, ros_message);
+  if (ret == RMW_RET_OK && message_info) {
+    fill_message_info(iceoryx_subscription, user_payload, message_info);
   }
+  iceoryx_receiver->release(user_payload);
+  *taken = (ret == RMW_RET_OK);
 
   return ret;
 }
+}  // namespace details
+
+rmw_ret_t
+rmw_take(
+  const rmw_subscription_t * subscription,
+  void * ros_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  return details::take_message(subscription, ros_message, taken, nullptr, allocation);
+}
 
 rmw_ret_t
 rmw_take_with_info(
@@ -130,24 +268,22 @@ rmw_take_with_info(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_ERROR);
-  (void)allocation;
 
-  /// @todo poehnl: implement message_info related stuff
-  (void)message_info;
-  return rmw_take(subscription, ros_message, taken, allocation);
+  return details::take_message(subscription, ros_message, taken, message_info, allocation);
 }
 
+namespace details
+{
 rmw_ret_t
-rmw_take_serialized_message(
+take_serialized_message(
   const rmw_subscription_t * subscription,
   rmw_serialized_message_t * serialized_message,
   bool * taken,
-  rmw_subscription_allocation_t * allocation)
+  rmw_message_info_t * message_info)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
-  (void)allocation;
 
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
     rmw_take
@@ -186,6 +322,7 @@ rmw_take_serialized_message(
   iceoryx_receiver->take()
   .and_then(
     [&](const void * userPayload) {
+      on_chunk_taken(iceoryx_subscription, userPayload);
       user_payload = userPayload;
       chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(user_payload);
     })
@@ -195,17 +332,61 @@ rmw_take_serialized_message(
       ret = RMW_RET_ERROR;
     });
 
+  if (ret != RMW_RET_OK) {
+    return ret;
+  }
+
+  if (get_payload_layout(user_payload, false) == rmw_iceoryx_cpp::PayloadLayout::FLAT) {
+    std::vector<char> payload_vector{};
+    try {
+      rmw_iceoryx_cpp::iceoryx_flat_to_serialized(
+        user_payload, chunk_header->userPayloadSize(),
+        &iceoryx_subscription->type_supports_, payload_vector);
+    } catch (const std::exception & e) {
+      iceoryx_receiver->release(user_payload);
+      RMW_SET_ERROR_MSG(e.what());
+      return RMW_RET_ERROR;
+    }
+    if (message_info) {
+      fill_message_info(iceoryx_subscription, user_payload, message_info);
+    }
+    iceoryx_receiver->release(user_payload);
+
+    ret = rmw_serialized_message_resize(serialized_message, payload_vector.size());
+    if (RMW_RET_OK == ret) {
+      memcpy(serialized_message->buffer, payload_vector.data(), payload_vector.size());
+      serialized_message->buffer_length = payload_vector.size();
+      *taken = true;
+    }
+    return ret;
+  }
+
   // all incoming data is serialzed already in memory, so simply call memcopy
   ret = rmw_serialized_message_resize(serialized_message, chunk_header->userPayloadSize());
   if (RMW_RET_OK == ret) {
     memcpy(serialized_message->buffer, user_payload, chunk_header->userPayloadSize());
     serialized_message->buffer_length = chunk_header->userPayloadSize();
-    iceoryx_receiver->release(user_payload);
+    if (message_info) {
+      fill_message_info(iceoryx_subscription, user_payload, message_info);
+    }
     *taken = true;
   }
+  iceoryx_receiver->release(user_payload);
 
   return ret;
 }
+}  // namespace details
+
+rmw_ret_t
+rmw_take_serialized_message(
+  const rmw_subscription_t * subscription,
+  rmw_serialized_message_t * serialized_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  (void)allocation;
+  return details::take_serialized_message(subscription, serialized_message, taken, nullptr);
+}
 
 rmw_ret_t
 rmw_take_serialized_message_with_info(
@@ -221,22 +402,21 @@ rmw_take_serialized_message_with_info(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_ERROR);
   (void)allocation;
 
-  /// @todo poehnl: implement message_info related stuff
-  (void) message_info;
-  return rmw_take_serialized_message(subscription, serialized_message, taken, allocation);
+  return details::take_serialized_message(subscription, serialized_message, taken, message_info);
 }
 
+namespace details
+{
 rmw_ret_t
-rmw_take_loaned_message(
+take_loaned_message(
   const rmw_subscription_t * subscription,
   void ** loaned_message,
   bool * taken,
-  rmw_subscription_allocation_t * allocation)
+  rmw_message_info_t * message_info)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(loaned_message, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
-  (void)allocation;
 
   *taken = false;
 
@@ -267,6 +447,8 @@ rmw_take_loaned_message(
 
   if (!iceoryx_subscription->is_fixed_size_) {
     /// @todo Karsten1987: Alternatively fall back to regular rmw_take with memcpy
+    /// flat messages can't be loaned either, their strings and sequences refer to the chunk by
+    /// offset and would need to be patched in shared memory. Use take_message_view() instead.
     RMW_SET_ERROR_MSG("iceoryx can't take loaned non-fixed size data stuctures");
     return RMW_RET_ERROR;
   }
@@ -275,7 +457,12 @@ rmw_take_loaned_message(
   iceoryx_receiver->take()
   .and_then(
     [&](const void * userPayload) {
+      on_chunk_taken(iceoryx_subscription, userPayload);
+      if (message_info) {
+        fill_message_info(iceoryx_subscription, userPayload, message_info);
+      }
       *loaned_message = const_cast<void *>(userPayload);
+      *taken = true;
       ret = RMW_RET_OK;
     })
   .or_else(
@@ -283,9 +470,20 @@ rmw_take_loaned_message(
       RMW_SET_ERROR_MSG("No chunk in iceoryx_receiver");
       ret = RMW_RET_ERROR;
     });
-  *taken = true;
 
-  return RMW_RET_OK;
+  return ret;
+}
+}  // namespace details
+
+rmw_ret_t
+rmw_take_loaned_message(
+  const rmw_subscription_t * subscription,
+  void ** loaned_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  (void)allocation;
+  return details::take_loaned_message(subscription, loaned_message, taken, nullptr);
 }
 
 rmw_ret_t
@@ -296,8 +494,9 @@ rmw_take_loaned_message_with_info(
   rmw_message_info_t * message_info,
   rmw_subscription_allocation_t * allocation)
 {
-  (void) message_info;
-  return rmw_take_loaned_message(subscription, loaned_message, taken, allocation);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_ERROR);
+  (void)allocation;
+  return details::take_loaned_message(subscription, loaned_message, taken, message_info);
 }
 
 rmw_ret_t
@@ -337,8 +536,34 @@ rmw_take_event(const rmw_event_t * event_handle, void * event_info, bool * taken
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(event_info, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support events.");
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_take_event
+    : event_handle, event_handle->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  *taken = false;
+
+  if (event_handle->event_type != RMW_EVENT_MESSAGE_LOST) {
+    RMW_SET_ERROR_MSG("rmw_iceoryx_cpp only supports the message lost event");
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  auto iceoryx_subscription = static_cast<IceoryxSubscription *>(event_handle->data);
+  if (!iceoryx_subscription) {
+    RMW_SET_ERROR_MSG("event data is null");
+    return RMW_RET_ERROR;
+  }
+
+  auto lost_message_count = iceoryx_subscription->lost_message_count_.load(
+    std::memory_order_relaxed);
+  auto reported_lost_message_count = iceoryx_subscription->reported_lost_message_count_.exchange(
+    lost_message_count, std::memory_order_relaxed);
+
+  auto message_lost_status = static_cast<rmw_message_lost_status_t *>(event_info);
+  message_lost_status->total_count = lost_message_count;
+  message_lost_status->total_count_change = lost_message_count - reported_lost_message_count;
+  *taken = true;
+  return RMW_RET_OK;
 }
 
 rmw_ret_t
@@ -349,15 +574,221 @@ rmw_take_sequence(
   rmw_message_info_sequence_t * message_info_sequence,
   size_t * taken,
   rmw_subscription_allocation_t * allocation)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_sequence, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info_sequence, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+
+  *taken = 0u;
+
+  if (count == 0u) {
+    RMW_SET_ERROR_MSG("count must be greater than 0");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  if (message_sequence->capacity < count) {
+    RMW_SET_ERROR_MSG("message_sequence capacity is smaller than count");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  if (message_info_sequence->capacity < count) {
+    RMW_SET_ERROR_MSG("message_info_sequence capacity is smaller than count");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    rmw_take_sequence
+    : subscription,
+    subscription->implementation_identifier,
+    rmw_get_implementation_identifier(),
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  IceoryxSubscriptionAllocation * subscription_allocation = nullptr;
+  if (allocation) {
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+      rmw_take_sequence
+      : allocation, allocation->implementation_identifier,
+      rmw_get_implementation_identifier(), return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+    subscription_allocation = static_cast<IceoryxSubscriptionAllocation *>(allocation->data);
+  }
+
+  auto iceoryx_subscription = static_cast<IceoryxSubscription *>(subscription->data);
+  if (!iceoryx_subscription) {
+    RMW_SET_ERROR_MSG("subscription data is null");
+    return RMW_RET_ERROR;
+  }
+
+  auto iceoryx_receiver = iceoryx_subscription->iceoryx_receiver_;
+  if (!iceoryx_receiver) {
+    RMW_SET_ERROR_MSG("iceoryx_receiver is null");
+    return RMW_RET_ERROR;
+  }
+
+  message_sequence->size = 0u;
+  message_info_sequence->size = 0u;
+
+  // Subscription is not matched
+  if (iox::SubscribeState::SUBSCRIBED != iceoryx_receiver->getSubscriptionState()) {
+    return RMW_RET_OK;
+  }
+
+  // this should never happen if checked already at rmw_create_subscription
+  if (!rmw_iceoryx_cpp::iceoryx_is_valid_type_support(&iceoryx_subscription->type_supports_)) {
+    RMW_SET_ERROR_MSG("Use either C typesupport or CPP typesupport");
+    return RMW_RET_ERROR;
+  }
+
+  // each chunk is deserialized and released right after it is taken, the taking stops at the
+  // first failure, so no chunk is taken without being delivered
+  rmw_ret_t ret = RMW_RET_OK;
+  bool has_data = true;
+  while (has_data && ret == RMW_RET_OK && *taken < count) {
+    iceoryx_receiver->take()
+    .and_then(
+      [&](const void * userPayload) {
+        details::on_chunk_taken(iceoryx_subscription, userPayload);
+        ret = details::deserialize_chunk(
+          iceoryx_subscription, subscription_allocation, userPayload,
+          message_sequence->data[*taken]);
+        if (ret == RMW_RET_OK) {
+          details::fill_message_info(
+            iceoryx_subscription, userPayload, &message_info_sequence->data[*taken]);
+          ++(*taken);
+        }
+        iceoryx_receiver->release(userPayload);
+      })
+    .or_else(
+      [&](iox::popo::ChunkReceiveResult result) {
+        has_data = false;
+        if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
+          // e.g. message views or loaned messages still hold the chunks of the subscriber
+          RMW_SET_ERROR_MSG("too many chunks held in parallel, return loaned messages first");
+          ret = RMW_RET_ERROR;
+        }
+      });
+  }
+
+  message_sequence->size = *taken;
+  message_info_sequence->size = *taken;
+
+  // the messages taken before the failure are delivered instead of being dropped with an error,
+  // the error is returned once nothing is taken anymore. The warning is throttled as the failure
+  // usually repeats with each call until the held chunks are returned.
+  if (ret != RMW_RET_OK && *taken > 0u) {
+    RCUTILS_LOG_WARN_THROTTLE_NAMED(
+      rcutils_steady_time_now, details::PARTIAL_TAKE_WARNING_PERIOD_MS,
+      "rmw_iceoryx_cpp", "rmw_take_sequence stopped after %zu messages: %s", *taken,
+      rcutils_get_error_string().str);
+    rcutils_reset_error();
+    ret = RMW_RET_OK;
+  }
+
+  return ret;
+}
+}  // extern "C"
+
+namespace rmw_iceoryx_cpp
+{
+rmw_ret_t
+take_message_view(
+  const rmw_subscription_t * subscription,
+  MessageView * message_view,
+  bool * taken)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
-  (void) count;
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_sequence, RMW_RET_ERROR);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info_sequence, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_view, RMW_RET_ERROR);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_ERROR);
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_ERROR);
 
-  RMW_SET_ERROR_MSG("rmw_iceoryx_cpp does not support rmw_take_sequence.");
-  return RMW_RET_UNSUPPORTED;
+  *taken = false;
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    take_message_view
+    : subscription,
+    subscription->implementation_identifier,
+    rmw_get_implementation_identifier(),
+    return RMW_RET_ERROR);
+
+  auto iceoryx_subscription = static_cast<IceoryxSubscription *>(subscription->data);
+  if (!iceoryx_subscription) {
+    RMW_SET_ERROR_MSG("subscription data is null");
+    return RMW_RET_ERROR;
+  }
+
+  auto iceoryx_receiver = iceoryx_subscription->iceoryx_receiver_;
+  if (!iceoryx_receiver) {
+    RMW_SET_ERROR_MSG("iceoryx_receiver is null");
+    return RMW_RET_ERROR;
+  }
+
+  // Subscription is not matched
+  if (iox::SubscribeState::SUBSCRIBED != iceoryx_receiver->getSubscriptionState()) {
+    return RMW_RET_OK;
+  }
+
+  rmw_ret_t ret = RMW_RET_OK;
+  iceoryx_receiver->take()
+  .and_then(
+    [&](const void * userPayload) {
+      ::details::on_chunk_taken(iceoryx_subscription, userPayload);
+      try {
+        auto chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(userPayload);
+        *message_view = MessageView(
+          userPayload,
+          chunk_header->userPayloadSize(),
+          &iceoryx_subscription->type_supports_,
+          get_payload_layout(userPayload, iceoryx_subscription->is_fixed_size_));
+        *taken = true;
+      } catch (const std::exception & e) {
+        // the chunk would be lost otherwise
+        iceoryx_receiver->release(userPayload);
+        RMW_SET_ERROR_MSG(e.what());
+        ret = RMW_RET_ERROR;
+      }
+    })
+  .or_else(
+    [&](iox::popo::ChunkReceiveResult result) {
+      if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
+        RMW_SET_ERROR_MSG("Could not take chunk from iceoryx_receiver");
+        ret = RMW_RET_ERROR;
+      }
+    });
+
+  return ret;
 }
-}  // extern "C"
+
+rmw_ret_t
+return_message_view(
+  const rmw_subscription_t * subscription,
+  MessageView * message_view)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_view, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    return_message_view
+    : subscription,
+    subscription->implementation_identifier,
+    rmw_get_implementation_identifier(),
+    return RMW_RET_ERROR);
+
+  if (!message_view->is_valid()) {
+    RMW_SET_ERROR_MSG("message view does not hold a chunk");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  auto iceoryx_subscription = static_cast<IceoryxSubscription *>(subscription->data);
+  if (!iceoryx_subscription) {
+    RMW_SET_ERROR_MSG("subscription data is null");
+    return RMW_RET_ERROR;
+  }
+
+  auto iceoryx_receiver = iceoryx_subscription->iceoryx_receiver_;
+  if (!iceoryx_receiver) {
+    RMW_SET_ERROR_MSG("iceoryx_receiver is null");
+    return RMW_RET_ERROR;
+  }
+
+  iceoryx_receiver->release(message_view->payload());
+  *message_view = MessageView();
+  return RMW_RET_OK;
+}
+}  // namespace rmw_iceoryx_cpp
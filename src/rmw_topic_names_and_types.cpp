@@ -24,6 +24,7 @@
 #include "rmw/names_and_types.h"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_topic_names_and_types.hpp"
 
 extern "C"
@@ -50,9 +51,11 @@ rmw_get_topic_names_and_types(
     return rmw_ret;  // error already set
   }
 
-  auto iceoryx_topic_names_and_types = rmw_iceoryx_cpp::get_topic_names_and_types();
-
-  return rmw_iceoryx_cpp::fill_rmw_names_and_types(
-    topic_names_and_types, iceoryx_topic_names_and_types, allocator);
+  // filled straight from the graph cache, without copying the topics
+  return rmw_iceoryx_cpp::get_graph_cache().read(
+    [&](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      return rmw_iceoryx_cpp::fill_rmw_names_and_types(
+        topic_names_and_types, graph, allocator);
+    });
 }
 }  // extern "C"
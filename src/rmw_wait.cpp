@@ -15,16 +15,374 @@
 
 #include <time.h>
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "iceoryx_posh/popo/listener.hpp"
 #include "iceoryx_posh/popo/untyped_subscriber.hpp"
-#include "iceoryx_posh/popo/wait_set.hpp"
 #include "iceoryx_posh/popo/user_trigger.hpp"
 
 #include "rcutils/error_handling.h"
 
+#include "rmw/event.h"
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_wait_spin.hpp"
+
+#include "./iceoryx_listener_pool.hpp"
+
+#include "./types/iceoryx_client.hpp"
+#include "./types/iceoryx_service.hpp"
 #include "./types/iceoryx_subscription.hpp"
+#include "./types/iceoryx_wait_set.hpp"
+
+namespace details
+{
+void on_overflow_data(iox::popo::UntypedSubscriber *, IceoryxWaitSetOverflow * overflow)
+{
+  overflow->trigger_.trigger();
+}
+
+void on_overflow_guard_condition(
+  iox::popo::UserTrigger * iceoryx_guard_condition,
+  IceoryxWaitSetOverflow * overflow)
+{
+  {
+    std::lock_guard<std::mutex> lock(overflow->triggered_mutex_);
+    overflow->triggered_guard_conditions_.insert(iceoryx_guard_condition);
+  }
+  overflow->trigger_.trigger();
+}
+
+/// @brief Attaches an entity to the listener pool of the process
+template<typename AttachFunction>
+bool attach_to_listener(
+  IceoryxWaitSetOverflow & overflow,
+  const void * entity,
+  AttachFunction attach)
+{
+  auto listener = attach_to_listener_pool(attach);
+  if (!listener) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(overflow.mutex_);
+  overflow.attached_[entity] = listener;
+  return true;
+}
+
+/// @return false if the entity is not attached to a listener
+template<typename DetachFunction>
+bool detach_from_listener(
+  IceoryxWaitSetOverflow & overflow,
+  const void * entity,
+  DetachFunction detach)
+{
+  {
+    std::lock_guard<std::mutex> lock(overflow.mutex_);
+    auto it = overflow.attached_.find(entity);
+    if (it == overflow.attached_.end()) {
+      return false;
+    }
+    detach(*it->second);
+    overflow.attached_.erase(it);
+  }
+  std::lock_guard<std::mutex> lock(overflow.triggered_mutex_);
+  overflow.triggered_guard_conditions_.erase(entity);
+  return true;
+}
+
+/// subscriptions, services and clients are ready when their iceoryx subscriber has data
+template<typename EntityT>
+iox::popo::UntypedSubscriber & receiver_of(EntityT & entity)
+{
+  return *entity.iceoryx_receiver_;
+}
+
+/// @brief Attaches to the WaitSet and falls back to a listener if the WaitSet is full
+template<typename EntityT>
+IceoryxAttachment attach(
+  IceoryxWaitSet & wait_set,
+  EntityT & entity,
+  uint64_t notification_id)
+{
+  auto & iceoryx_receiver = receiver_of(entity);
+  if (wait_set.waitset_->attach(iceoryx_receiver, notification_id)) {
+    return IceoryxAttachment::WAIT_SET;
+  }
+  auto & overflow = wait_set.overflow_;
+  bool attached = attach_to_listener(
+    overflow, &entity, [&](iox::popo::Listener & listener) {
+      return !listener.attachEvent(
+        iceoryx_receiver, iox::popo::SubscriberEvent::DATA_RECEIVED,
+        iox::popo::createNotificationCallback(on_overflow_data, overflow)).has_error();
+    });
+  return attached ? IceoryxAttachment::LISTENER : IceoryxAttachment::NONE;
+}
+
+IceoryxAttachment attach(
+  IceoryxWaitSet & wait_set,
+  iox::popo::UserTrigger & iceoryx_guard_condition,
+  uint64_t notification_id)
+{
+  if (wait_set.waitset_->attach(iceoryx_guard_condition, notification_id)) {
+    return IceoryxAttachment::WAIT_SET;
+  }
+  auto & overflow = wait_set.overflow_;
+  bool attached = attach_to_listener(
+    overflow, &iceoryx_guard_condition, [&](iox::popo::Listener & listener) {
+      return !listener.attachEvent(
+        iceoryx_guard_condition,
+        iox::popo::createNotificationCallback(on_overflow_guard_condition, overflow)).has_error();
+    });
+  return attached ? IceoryxAttachment::LISTENER : IceoryxAttachment::NONE;
+}
+
+template<typename EntityT>
+void detach(IceoryxWaitSet & wait_set, EntityT & entity)
+{
+  auto & iceoryx_receiver = receiver_of(entity);
+  if (!detach_from_listener(
+      wait_set.overflow_, &entity, [&](iox::popo::Listener & listener) {
+        listener.detachEvent(iceoryx_receiver, iox::popo::SubscriberEvent::DATA_RECEIVED);
+      }))
+  {
+    wait_set.waitset_->detach(iceoryx_receiver);
+  }
+}
+
+void detach(IceoryxWaitSet & wait_set, iox::popo::UserTrigger & iceoryx_guard_condition)
+{
+  if (!detach_from_listener(
+      wait_set.overflow_, &iceoryx_guard_condition, [&](iox::popo::Listener & listener) {
+        listener.detachEvent(iceoryx_guard_condition);
+      }))
+  {
+    wait_set.waitset_->detach(iceoryx_guard_condition);
+  }
+}
+
+/// @brief Detaches an entity of one kind from a wait set and frees its slot
+template<typename EntityT>
+bool drop_attachment(
+  IceoryxWaitSet & wait_set,
+  IceoryxAttachments<EntityT> & attachments,
+  const void * entity)
+{
+  auto dropped = drop_attachment_slot(attachments, entity);
+  if (!dropped) {
+    return false;
+  }
+  detach(wait_set, *dropped);
+  return true;
+}
+
+enum class UpdateResult
+{
+  ATTACHED,
+  /// an entity is attached to a wait set inside rmw_wait, which was asked to release it
+  HELD_ELSEWHERE,
+  FAILED,
+  /// an entity has an event fd and can't be attached to a wait set anymore
+  REJECTED
+};
+
+/// @brief Attaches and detaches the difference between the attached and the requested entities
+/// @param id_offset added to the slot of an entity to get its notification id
+template<typename EntityT>
+UpdateResult update_attachments(
+  IceoryxWaitSet * wait_set,
+  IceoryxAttachments<EntityT> & attachments,
+  void * const * entities,
+  size_t count,
+  uint64_t id_offset)
+{
+  bool failed{false};
+  bool rejected{false};
+  bool attached = update_attachment_slots(
+    attachments, entities, count,
+    [&](EntityT & entity, size_t slot) {
+      // iceoryx supports a single WaitSet or listener per entity
+      switch (acquire_attachment(&entity, wait_set)) {
+        case IceoryxAcquireResult::ACQUIRED:
+          break;
+        case IceoryxAcquireResult::HELD_ELSEWHERE:
+          return IceoryxAttachment::NONE;
+        case IceoryxAcquireResult::EVENT_FD:
+          rejected = true;
+          return IceoryxAttachment::NONE;
+      }
+      auto attachment = attach(*wait_set, entity, id_offset + slot);
+      if (attachment == IceoryxAttachment::NONE) {
+        release_attachment(&entity, wait_set);
+        failed = true;
+      }
+      return attachment;
+    },
+    [&](EntityT & entity) {
+      detach(*wait_set, entity);
+      release_attachment(&entity, wait_set);
+    });
+  if (attached) {
+    return UpdateResult::ATTACHED;
+  }
+  if (rejected) {
+    return UpdateResult::REJECTED;
+  }
+  return failed ? UpdateResult::FAILED : UpdateResult::HELD_ELSEWHERE;
+}
+
+/// @brief Attaches the entities of one kind
+/// @param[out] skip_wait set if an entity is not attached, rmw_wait polls the entities then
+/// @return RMW_RET_ERROR if an entity has an event fd
+template<typename EntityT>
+rmw_ret_t update_attachments(
+  IceoryxWaitSet * wait_set,
+  IceoryxAttachments<EntityT> & attachments,
+  void * const * entities,
+  size_t count,
+  uint64_t id_offset,
+  const char * error_message,
+  bool & skip_wait)
+{
+  switch (update_attachments(wait_set, attachments, entities, count, id_offset)) {
+    case UpdateResult::ATTACHED:
+      break;
+    case UpdateResult::HELD_ELSEWHERE:
+      skip_wait = true;
+      break;
+    case UpdateResult::FAILED:
+      RMW_SET_ERROR_MSG(error_message);
+      skip_wait = true;
+      break;
+    case UpdateResult::REJECTED:
+      RMW_SET_ERROR_MSG("entity has an event fd, it can't be waited on with rmw_wait");
+      return RMW_RET_ERROR;
+  }
+  return RMW_RET_OK;
+}
+
+bool has_listener_attachments(IceoryxWaitSet * wait_set)
+{
+  std::lock_guard<std::mutex> lock(wait_set->overflow_.mutex_);
+  return !wait_set->overflow_.attached_.empty();
+}
+
+/// @brief Checks the subscribers of the entities on a listener
+/// @return true if an entity has data
+template<typename EntityT>
+bool mark_receivers_ready_on_listener(
+  const IceoryxAttachments<EntityT> & attachments,
+  void ** entities)
+{
+  bool ready{false};
+  for (size_t slot = 0; slot < attachments.slots_.size(); ++slot) {
+    auto entity = attachments.slots_[slot];
+    if (entity && attachments.on_listener_[slot] && receiver_of(*entity).hasData()) {
+      if (entities) {
+        entities[attachments.positions_[slot]] = entity;
+      }
+      ready = true;
+    }
+  }
+  return ready;
+}
+
+/// @brief Checks the entities on a listener, a listener only notifies about changes
+/// @param entities entity lists of rmw_wait, the ready entities are put back into them
+/// @return true if an entity is ready
+bool mark_ready_on_listener(
+  IceoryxWaitSet * wait_set,
+  void ** subscriptions,
+  void ** guard_conditions,
+  void ** services,
+  void ** clients)
+{
+  bool ready = mark_receivers_ready_on_listener(wait_set->subscriptions_, subscriptions);
+  ready = mark_receivers_ready_on_listener(wait_set->services_, services) || ready;
+  ready = mark_receivers_ready_on_listener(wait_set->clients_, clients) || ready;
+
+  auto & overflow = wait_set->overflow_;
+  std::lock_guard<std::mutex> lock(overflow.triggered_mutex_);
+  if (overflow.triggered_guard_conditions_.empty()) {
+    return ready;
+  }
+  if (!guard_conditions) {
+    return true;
+  }
+  const auto & iceoryx_guard_conditions = wait_set->guard_conditions_;
+  for (size_t slot = 0; slot < iceoryx_guard_conditions.slots_.size(); ++slot) {
+    auto iceoryx_guard_condition = iceoryx_guard_conditions.slots_[slot];
+    if (iceoryx_guard_condition && iceoryx_guard_conditions.on_listener_[slot] &&
+      overflow.triggered_guard_conditions_.count(iceoryx_guard_condition) > 0u)
+    {
+      guard_conditions[iceoryx_guard_conditions.positions_[slot]] = iceoryx_guard_condition;
+    }
+  }
+  overflow.triggered_guard_conditions_.clear();
+  return true;
+}
+
+/// @brief Nulls the events without a change to report, see rmw_take_event
+/// @return true if an event is ready
+bool mark_ready_events(rmw_events_t * events)
+{
+  bool ready{false};
+  for (size_t i = 0; i < events->event_count; ++i) {
+    auto event = static_cast<rmw_event_t *>(events->events[i]);
+    auto iceoryx_subscription = static_cast<IceoryxSubscription *>(event->data);
+    if (event->event_type == RMW_EVENT_MESSAGE_LOST && iceoryx_subscription &&
+      iceoryx_subscription->lost_message_count_.load(std::memory_order_relaxed) !=
+      iceoryx_subscription->reported_lost_message_count_.load(std::memory_order_relaxed))
+    {
+      ready = true;
+    } else {
+      events->events[i] = nullptr;
+    }
+  }
+  return ready;
+}
+
+/// @brief Hint to the processor that it is in a busy-wait loop
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile ("yield");
+#endif
+}
+
+/// @brief Polls the subscriptions until one of them has data or the spin duration elapsed
+/// @param[out] elapsed_ns time spent spinning
+/// @return true if a subscription has data
+bool spin_for_data(
+  const rmw_subscriptions_t * subscriptions,
+  uint64_t spin_duration_ns,
+  uint64_t & elapsed_ns)
+{
+  auto start = std::chrono::steady_clock::now();
+  while (true) {
+    for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
+      auto iceoryx_subscription =
+        static_cast<IceoryxSubscription *>(subscriptions->subscribers[i]);
+      if (iceoryx_subscription->iceoryx_receiver_->hasData()) {
+        return true;
+      }
+    }
+    elapsed_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    if (elapsed_ns >= spin_duration_ns) {
+      return false;
+    }
+    cpu_relax();
+  }
+}
+}  // namespace details
 
 extern "C"
 {
@@ -50,82 +408,229 @@ rmw_wait(
     : waitset, wait_set->implementation_identifier,
     rmw_get_implementation_identifier(), return RMW_RET_ERROR);
 
-  iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET> * waitset =
-    static_cast<iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET> *>(wait_set->data);
-  if (!waitset) {
+  auto iceoryx_wait_set = static_cast<IceoryxWaitSet *>(wait_set->data);
+  if (!iceoryx_wait_set) {
     return RMW_RET_ERROR;
   }
+  auto & waitset = *iceoryx_wait_set->waitset_;
 
-  bool skip_wait{false};
-  // attach all iceoryx subscriber to WaitSet
-  for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
-    auto iceoryx_subscription =
-      static_cast<IceoryxSubscription *>(subscriptions->subscribers[i]);
-    auto iceoryx_receiver = iceoryx_subscription->iceoryx_receiver_;
+  enter_wait(iceoryx_wait_set);
 
-    waitset->attachState(*iceoryx_receiver, iox::popo::SubscriberState::HAS_DATA).or_else(
-      [&](auto &) {
-        RMW_SET_ERROR_MSG("failed to attach subscriber");
-        skip_wait = true;
-      });
+  bool skip_wait{false};
+  // the entities stay attached to the WaitSet, only the changes since the last call are applied
+  rmw_ret_t ret = details::update_attachments(
+    iceoryx_wait_set, iceoryx_wait_set->subscriptions_,
+    subscriptions->subscribers, subscriptions->subscriber_count,
+    notification_id::SUBSCRIPTION_OFFSET, "failed to attach subscriber", skip_wait);
+  if (ret == RMW_RET_OK) {
+    ret = details::update_attachments(
+      iceoryx_wait_set, iceoryx_wait_set->guard_conditions_,
+      guard_conditions->guard_conditions, guard_conditions->guard_condition_count,
+      notification_id::GUARD_CONDITION_OFFSET, "failed to attach guard condition", skip_wait);
   }
-
-
-  // attach all guard conditions to WaitSet
-  for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
-    auto iceoryx_guard_condition =
-      static_cast<iox::popo::UserTrigger *>(guard_conditions->guard_conditions[i]);
-
-    waitset->attachEvent(*iceoryx_guard_condition).or_else(
-      [&](auto) {
-        RMW_SET_ERROR_MSG("failed to attach guard condition");
-        skip_wait = true;
-      });
+  if (ret == RMW_RET_OK) {
+    ret = details::update_attachments(
+      iceoryx_wait_set, iceoryx_wait_set->services_,
+      services->services, services->service_count,
+      notification_id::SERVICE_OFFSET, "failed to attach service", skip_wait);
+  }
+  if (ret == RMW_RET_OK) {
+    ret = details::update_attachments(
+      iceoryx_wait_set, iceoryx_wait_set->clients_,
+      clients->clients, clients->client_count,
+      notification_id::CLIENT_OFFSET, "failed to attach client", skip_wait);
+  }
+  if (ret != RMW_RET_OK) {
+    leave_wait(iceoryx_wait_set);
+    return ret;
   }
 
+  // the lost messages are counted when taking, so events don't wake up the WaitSet
+  bool events_ready = details::mark_ready_events(events);
+
   if (skip_wait) {
-    goto after_wait;
+    goto poll_entities;
   }
 
-  if (!wait_timeout) {
-    /// @todo Check triggered subscribers in vector? Is that relevant for rmw?
-    auto notificationVector = waitset->wait();
-  } else {
-    auto sec = iox::units::Duration::fromSeconds(wait_timeout->sec);
-    auto nsec = iox::units::Duration::fromNanoseconds(wait_timeout->nsec);
-    auto timeout = sec + nsec;
+  {
+    auto & notification_ids = iceoryx_wait_set->notification_ids_;
+    bool uses_listeners = details::has_listener_attachments(iceoryx_wait_set);
+    uint64_t spin_duration_ns = iceoryx_wait_set->spin_duration_ns_.load(std::memory_order_relaxed);
+    uint64_t spin_elapsed_ns = 0u;
+    bool spin_found_data{false};
+    if (wait_timeout) {
+      spin_duration_ns = std::min<uint64_t>(
+        spin_duration_ns,
+        iox::units::Duration::fromSeconds(wait_timeout->sec).toNanoseconds() +
+        wait_timeout->nsec);
+    }
+    if (spin_duration_ns > 0u && subscriptions->subscriber_count > 0u) {
+      spin_found_data = details::spin_for_data(subscriptions, spin_duration_ns, spin_elapsed_ns);
+      iceoryx_wait_set->spin_count_.fetch_add(1u, std::memory_order_relaxed);
+      if (spin_found_data) {
+        iceoryx_wait_set->spin_success_count_.fetch_add(1u, std::memory_order_relaxed);
+      }
+    }
+
+    if (events_ready || spin_found_data ||
+      (uses_listeners && details::mark_ready_on_listener(
+        iceoryx_wait_set, nullptr, nullptr, nullptr, nullptr)))
+    {
+      // collects the notifications without blocking
+      auto timeout = iox::units::Duration::fromNanoseconds(0u);
+      waitset.wait(&timeout, notification_ids);
+    } else if (!wait_timeout) {
+      waitset.wait(nullptr, notification_ids);
+    } else {
+      auto sec = iox::units::Duration::fromSeconds(wait_timeout->sec);
+      auto nsec = iox::units::Duration::fromNanoseconds(wait_timeout->nsec);
+      auto timeout = sec + nsec;
+      // the spin phase is part of the timeout
+      auto spin_elapsed = iox::units::Duration::fromNanoseconds(spin_elapsed_ns);
+      timeout = (spin_elapsed < timeout) ? timeout - spin_elapsed :
+        iox::units::Duration::fromNanoseconds(0u);
 
-    /// @todo Check triggered subscribers in vector? Is that relevant for rmw?
-    auto notificationVector = waitset->timedWait(iox::units::Duration(timeout));
+      waitset.wait(&timeout, notification_ids);
+    }
+
+    // only the entities in the notification vector are ready, their notification id is the slot
+    // rcl passes every entity again with each call and takes the non-null entries as ready, so
+    // every entry has to be written in any case. Clearing all of them and putting the notified
+    // ones back is O(attached) like nulling only the non-ready ones, but needs no lookup per entry
+    // and is no more than the comparison with the last entity list in update_attachment_slots.
+    std::fill(
+      subscriptions->subscribers, subscriptions->subscribers + subscriptions->subscriber_count,
+      nullptr);
+    std::fill(
+      guard_conditions->guard_conditions,
+      guard_conditions->guard_conditions + guard_conditions->guard_condition_count,
+      nullptr);
+    std::fill(services->services, services->services + services->service_count, nullptr);
+    std::fill(clients->clients, clients->clients + clients->client_count, nullptr);
+    for (auto id : notification_ids) {
+      if (id == notification_id::OVERFLOW) {
+        continue;
+      }
+      auto slot = notification_id::slot_of(id);
+      switch (notification_id::offset_of(id)) {
+        case notification_id::SUBSCRIPTION_OFFSET:
+          mark_ready(iceoryx_wait_set->subscriptions_, slot, subscriptions->subscribers);
+          break;
+        case notification_id::GUARD_CONDITION_OFFSET:
+          mark_ready(
+            iceoryx_wait_set->guard_conditions_, slot, guard_conditions->guard_conditions);
+          break;
+        case notification_id::SERVICE_OFFSET:
+          mark_ready(iceoryx_wait_set->services_, slot, services->services);
+          break;
+        case notification_id::CLIENT_OFFSET:
+          mark_ready(iceoryx_wait_set->clients_, slot, clients->clients);
+          break;
+        default:
+          break;
+      }
+    }
+    if (uses_listeners) {
+      details::mark_ready_on_listener(
+        iceoryx_wait_set, subscriptions->subscribers, guard_conditions->guard_conditions,
+        services->services, clients->clients);
+    }
   }
+  leave_wait(iceoryx_wait_set);
+  return RMW_RET_OK;
 
-after_wait:
-  // reset all the subscriptions that don't have new data
+poll_entities:
+  // not all entities could be attached, check each of them
   for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
     auto iceoryx_subscription =
       static_cast<IceoryxSubscription *>(subscriptions->subscribers[i]);
     iox::popo::UntypedSubscriber * iceoryx_receiver = iceoryx_subscription->iceoryx_receiver_;
 
-    // remove waitset from all receivers because next call a new waitset could be provided
-    waitset->detachState(*iceoryx_receiver, iox::popo::SubscriberState::HAS_DATA);
-
     if (!iceoryx_receiver->hasData()) {
       subscriptions->subscribers[i] = nullptr;
     }
   }
 
-  // reset all the guard_conditions that have not triggered
   for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
     auto iceoryx_guard_condition =
       static_cast<iox::popo::UserTrigger *>(guard_conditions->guard_conditions[i]);
 
-    waitset->detachEvent(*iceoryx_guard_condition);
-
     if (!iceoryx_guard_condition->hasTriggered()) {
       guard_conditions->guard_conditions[i] = nullptr;
     }
   }
 
+  for (size_t i = 0; i < services->service_count; ++i) {
+    auto iceoryx_service = static_cast<IceoryxService *>(services->services[i]);
+
+    if (!iceoryx_service->iceoryx_receiver_->hasData()) {
+      services->services[i] = nullptr;
+    }
+  }
+
+  for (size_t i = 0; i < clients->client_count; ++i) {
+    auto iceoryx_client = static_cast<IceoryxClient *>(clients->clients[i]);
+
+    if (!iceoryx_client->iceoryx_receiver_->hasData()) {
+      clients->clients[i] = nullptr;
+    }
+  }
+
+  leave_wait(iceoryx_wait_set);
   return RMW_RET_OK;
 }
 }  // extern "C"
+
+bool drop_attachment(IceoryxWaitSet & wait_set, const void * entity)
+{
+  return details::drop_attachment(wait_set, wait_set.subscriptions_, entity) ||
+         details::drop_attachment(wait_set, wait_set.guard_conditions_, entity) ||
+         details::drop_attachment(wait_set, wait_set.services_, entity) ||
+         details::drop_attachment(wait_set, wait_set.clients_, entity);
+}
+
+namespace rmw_iceoryx_cpp
+{
+rmw_ret_t set_wait_spin_duration(rmw_wait_set_t * wait_set, uint64_t spin_duration_us)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(wait_set, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    set_wait_spin_duration
+    : waitset, wait_set->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_wait_set = static_cast<IceoryxWaitSet *>(wait_set->data);
+  if (!iceoryx_wait_set) {
+    RMW_SET_ERROR_MSG("wait set data is null");
+    return RMW_RET_ERROR;
+  }
+
+  iceoryx_wait_set->spin_duration_ns_.store(spin_duration_us * 1000u, std::memory_order_relaxed);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t get_wait_spin_statistics(
+  const rmw_wait_set_t * wait_set,
+  WaitSpinStatistics * statistics)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(wait_set, RMW_RET_ERROR);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(statistics, RMW_RET_ERROR);
+
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    get_wait_spin_statistics
+    : waitset, wait_set->implementation_identifier,
+    rmw_get_implementation_identifier(), return RMW_RET_ERROR);
+
+  auto iceoryx_wait_set = static_cast<const IceoryxWaitSet *>(wait_set->data);
+  if (!iceoryx_wait_set) {
+    RMW_SET_ERROR_MSG("wait set data is null");
+    return RMW_RET_ERROR;
+  }
+
+  statistics->spin_count = iceoryx_wait_set->spin_count_.load(std::memory_order_relaxed);
+  statistics->spin_success_count =
+    iceoryx_wait_set->spin_success_count_.load(std::memory_order_relaxed);
+  return RMW_RET_OK;
+}
+}  // namespace rmw_iceoryx_cpp
@@ -13,23 +13,259 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "./iceoryx_identifier.hpp"
 
-#include "iceoryx_posh/roudi/introspection_types.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+#include "iceoryx_posh/popo/user_trigger.hpp"
 #include "iceoryx_posh/popo/wait_set.hpp"
+#include "iceoryx_posh/roudi/introspection_types.hpp"
 
 #include "rcutils/error_handling.h"
+#include "rcutils/get_env.h"
 
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_wait_spin.hpp"
+
+#include "./types/iceoryx_wait_set.hpp"
+
+namespace details
+{
+std::mutex attachment_mutex;
+/// notified when a wait set released the entities other threads asked for
+std::condition_variable attachment_released;
+/// wait set which currently has the entity attached
+std::unordered_map<const void *, IceoryxWaitSet *> attachment_owners;
+/// entities attached to the listener of their event fd
+std::unordered_set<const void *> event_fd_entities;
+
+/// @brief Asks a wait set inside rmw_wait to release entity when it leaves rmw_wait
+void request_release(IceoryxWaitSet * owner, const void * entity)
+{
+  auto & releases = owner->requests_.releases_;
+  if (std::find(releases.begin(), releases.end(), entity) == releases.end()) {
+    releases.push_back(entity);
+    owner->overflow_.trigger_.trigger();
+  }
+}
+
+/// @brief Detaches entity from the wait set holding it, waits for a wait set inside rmw_wait
+void take_from_wait_set(std::unique_lock<std::mutex> & lock, const void * entity)
+{
+  while (true) {
+    auto it = attachment_owners.find(entity);
+    if (it == attachment_owners.end()) {
+      return;
+    }
+    auto owner = it->second;
+    if (!owner->requests_.in_wait_) {
+      drop_attachment(*owner, entity);
+      attachment_owners.erase(it);
+      return;
+    }
+    request_release(owner, entity);
+    attachment_released.wait(lock);
+  }
+}
+
+template<uint64_t Capacity>
+class WaitSetBackend : public IceoryxWaitSetBackend
+{
+public:
+  bool attach(iox::popo::UntypedSubscriber & iceoryx_receiver, uint64_t notification_id) override
+  {
+    return !waitset_.attachState(
+      iceoryx_receiver, iox::popo::SubscriberState::HAS_DATA, notification_id).has_error();
+  }
+
+  bool attach(iox::popo::UserTrigger & iceoryx_trigger, uint64_t notification_id) override
+  {
+    return !waitset_.attachEvent(iceoryx_trigger, notification_id).has_error();
+  }
+
+  void detach(iox::popo::UntypedSubscriber & iceoryx_receiver) override
+  {
+    waitset_.detachState(iceoryx_receiver, iox::popo::SubscriberState::HAS_DATA);
+  }
+
+  void detach(iox::popo::UserTrigger & iceoryx_trigger) override
+  {
+    waitset_.detachEvent(iceoryx_trigger);
+  }
+
+  void wait(
+    const iox::units::Duration * timeout,
+    std::vector<uint64_t> & notification_ids) override
+  {
+    auto notifications = timeout ? waitset_.timedWait(*timeout) : waitset_.wait();
+    notification_ids.clear();
+    for (auto notification : notifications) {
+      notification_ids.push_back(notification->getNotificationId());
+    }
+  }
+
+  uint64_t capacity() const override
+  {
+    return Capacity;
+  }
+
+private:
+  iox::popo::WaitSet<Capacity> waitset_;
+};
+
+/// capacities of the WaitSets, each attachment costs memory for its trigger and notification
+constexpr uint64_t SMALL_WAIT_SET_CAPACITY = 8u;
+constexpr uint64_t MEDIUM_WAIT_SET_CAPACITY = 32u;
+static_assert(
+  MEDIUM_WAIT_SET_CAPACITY < iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET,
+  "the largest WaitSet has to be the largest capacity");
+
+uint64_t default_spin_duration_ns()
+{
+  static const uint64_t spin_duration_ns = [] {
+      const char * value = nullptr;
+      if (rcutils_get_env(rmw_iceoryx_cpp::WAIT_SPIN_DURATION_ENV_VAR, &value) != nullptr ||
+        value == nullptr)
+      {
+        return uint64_t{0u};
+      }
+      return static_cast<uint64_t>(std::strtoull(value, nullptr, 10)) * 1000u;
+    }();
+  return spin_duration_ns;
+}
+}  // namespace details
+
+std::unique_ptr<IceoryxWaitSetBackend> make_iceoryx_wait_set_backend(size_t max_conditions)
+{
+  // one attachment is taken by the overflow trigger
+  uint64_t attachments = max_conditions + 1u;
+  if (max_conditions > 0u && attachments <= details::SMALL_WAIT_SET_CAPACITY) {
+    return std::unique_ptr<IceoryxWaitSetBackend>(
+      new (std::nothrow) details::WaitSetBackend<details::SMALL_WAIT_SET_CAPACITY>());
+  }
+  if (max_conditions > 0u && attachments <= details::MEDIUM_WAIT_SET_CAPACITY) {
+    return std::unique_ptr<IceoryxWaitSetBackend>(
+      new (std::nothrow) details::WaitSetBackend<details::MEDIUM_WAIT_SET_CAPACITY>());
+  }
+  return std::unique_ptr<IceoryxWaitSetBackend>(
+    new (std::nothrow) details::WaitSetBackend<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET>());
+}
+
+IceoryxAcquireResult acquire_attachment(const void * entity, IceoryxWaitSet * wait_set)
+{
+  std::lock_guard<std::mutex> lock(details::attachment_mutex);
+  if (details::event_fd_entities.count(entity) > 0u) {
+    return IceoryxAcquireResult::EVENT_FD;
+  }
+  IceoryxWaitSet *& owner = details::attachment_owners[entity];
+  if (owner && owner != wait_set) {
+    if (owner->requests_.in_wait_) {
+      details::request_release(owner, entity);
+      return IceoryxAcquireResult::HELD_ELSEWHERE;
+    }
+    // the owner can't enter rmw_wait while the registry is locked
+    drop_attachment(*owner, entity);
+  }
+  owner = wait_set;
+  return IceoryxAcquireResult::ACQUIRED;
+}
+
+void release_attachment(const void * entity, const IceoryxWaitSet * wait_set)
+{
+  std::lock_guard<std::mutex> lock(details::attachment_mutex);
+  auto it = details::attachment_owners.find(entity);
+  if (it != details::attachment_owners.end() && it->second == wait_set) {
+    details::attachment_owners.erase(it);
+  }
+}
+
+void take_from_wait_set(const void * entity)
+{
+  std::unique_lock<std::mutex> lock(details::attachment_mutex);
+  details::take_from_wait_set(lock, entity);
+}
+
+void take_for_event_fd(const void * entity)
+{
+  std::unique_lock<std::mutex> lock(details::attachment_mutex);
+  details::take_from_wait_set(lock, entity);
+  details::event_fd_entities.insert(entity);
+}
+
+void return_from_event_fd(const void * entity)
+{
+  std::lock_guard<std::mutex> lock(details::attachment_mutex);
+  details::event_fd_entities.erase(entity);
+}
+
+void enter_wait(IceoryxWaitSet * wait_set)
+{
+  std::lock_guard<std::mutex> lock(details::attachment_mutex);
+  wait_set->requests_.in_wait_ = true;
+}
+
+void leave_wait(IceoryxWaitSet * wait_set)
+{
+  std::lock_guard<std::mutex> lock(details::attachment_mutex);
+  auto & requests = wait_set->requests_;
+  requests.in_wait_ = false;
+  if (requests.releases_.empty()) {
+    return;
+  }
+  for (auto entity : requests.releases_) {
+    drop_attachment(*wait_set, entity);
+    auto it = details::attachment_owners.find(entity);
+    if (it != details::attachment_owners.end() && it->second == wait_set) {
+      details::attachment_owners.erase(it);
+    }
+  }
+  requests.releases_.clear();
+  details::attachment_released.notify_all();
+}
+
+namespace details
+{
+template<typename EntityT>
+void release_attachments(IceoryxWaitSet * wait_set, IceoryxAttachments<EntityT> & attachments)
+{
+  for (auto entity : std::vector<EntityT *>(attachments.slots_)) {
+    if (entity) {
+      drop_attachment(*wait_set, entity);
+      attachment_owners.erase(entity);
+    }
+  }
+}
+}  // namespace details
+
+void release_attachments(IceoryxWaitSet * wait_set)
+{
+  std::lock_guard<std::mutex> lock(details::attachment_mutex);
+  details::release_attachments(wait_set, wait_set->subscriptions_);
+  details::release_attachments(wait_set, wait_set->guard_conditions_);
+  details::release_attachments(wait_set, wait_set->services_);
+  details::release_attachments(wait_set, wait_set->clients_);
+  // threads waiting for this wait set find the entities released
+  wait_set->requests_.releases_.clear();
+  details::attachment_released.notify_all();
+}
+
 extern "C"
 {
 rmw_wait_set_t *
 rmw_create_wait_set(rmw_context_t * context, size_t max_conditions)
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(context, nullptr);
-  (void)max_conditions;
 
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
     rmw_create_wait_set
@@ -37,7 +273,7 @@ rmw_create_wait_set(rmw_context_t * context, size_t max_conditions)
     rmw_get_implementation_identifier(), return nullptr);
 
   rmw_wait_set_t * rmw_wait_set = nullptr;
-  iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET> * waitset = nullptr;
+  IceoryxWaitSet * iceoryx_wait_set = nullptr;
 
   rmw_wait_set = rmw_wait_set_allocate();
   if (!rmw_wait_set) {
@@ -48,28 +284,47 @@ rmw_create_wait_set(rmw_context_t * context, size_t max_conditions)
   rmw_wait_set->implementation_identifier = rmw_get_implementation_identifier();
 
   // create waitset
-  waitset = static_cast<iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET> *>(
-    rmw_allocate(sizeof(iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET>)));
-  if (!waitset) {
+  iceoryx_wait_set = static_cast<IceoryxWaitSet *>(rmw_allocate(sizeof(IceoryxWaitSet)));
+  if (!iceoryx_wait_set) {
     RMW_SET_ERROR_MSG("failed to allocate memory for wait_set data");
     goto fail;
   }
   RMW_TRY_PLACEMENT_NEW(
-    waitset,
-    waitset,
+    iceoryx_wait_set,
+    iceoryx_wait_set,
     goto fail,
-    iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET>);
+    IceoryxWaitSet);
+  // the WaitSet is sized for max_conditions, entities beyond its capacity are attached to the
+  // listener pool and wake it up through the overflow trigger
+  iceoryx_wait_set->waitset_ = make_iceoryx_wait_set_backend(max_conditions);
+  if (!iceoryx_wait_set->waitset_) {
+    RMW_SET_ERROR_MSG("failed to allocate iceoryx wait set");
+    goto fail;
+  }
+  try {
+    iceoryx_wait_set->notification_ids_.reserve(iceoryx_wait_set->waitset_->capacity());
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate notification ids");
+    goto fail;
+  }
+  if (!iceoryx_wait_set->waitset_->attach(
+      iceoryx_wait_set->overflow_.trigger_, notification_id::OVERFLOW))
+  {
+    RMW_SET_ERROR_MSG("failed to attach overflow trigger to wait set");
+    goto fail;
+  }
+  iceoryx_wait_set->spin_duration_ns_ = details::default_spin_duration_ns();
 
-  rmw_wait_set->data = static_cast<void *>(waitset);
+  rmw_wait_set->data = static_cast<void *>(iceoryx_wait_set);
   return rmw_wait_set;
 
 fail:
   if (rmw_wait_set) {
-    if (waitset) {
+    if (iceoryx_wait_set) {
       RMW_TRY_DESTRUCTOR_FROM_WITHIN_FAILURE(
-        waitset->~WaitSet(),
-        iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET>)
-      rmw_free(waitset);
+        iceoryx_wait_set->~IceoryxWaitSet(),
+        IceoryxWaitSet)
+      rmw_free(iceoryx_wait_set);
     }
 
     rmw_wait_set_free(rmw_wait_set);
@@ -89,12 +344,13 @@ rmw_destroy_wait_set(rmw_wait_set_t * wait_set)
 
   rmw_ret_t result = RMW_RET_OK;
 
-  auto iceoryx_wait_set =
-    static_cast<iox::popo::WaitSet<iox::MAX_NUMBER_OF_ATTACHMENTS_PER_WAITSET> *>(wait_set->data);
+  auto iceoryx_wait_set = static_cast<IceoryxWaitSet *>(wait_set->data);
 
   if (iceoryx_wait_set) {
+    // other wait sets may attach the entities as soon as they are released
+    release_attachments(iceoryx_wait_set);
     RMW_TRY_DESTRUCTOR(
-      iceoryx_wait_set->~WaitSet(),
+      iceoryx_wait_set->~IceoryxWaitSet(),
       iceoryx_wait_set,
       result = RMW_RET_ERROR)
     rmw_free(iceoryx_wait_set);
@@ -0,0 +1,180 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPES__ICEORYX_ATTACHMENTS_HPP_
+#define TYPES__ICEORYX_ATTACHMENTS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// The notification id of an entity attached to a WaitSet tells its kind in the upper half and
+/// its slot in the lower half
+namespace notification_id
+{
+constexpr uint64_t SUBSCRIPTION_OFFSET = 0u;
+constexpr uint64_t GUARD_CONDITION_OFFSET = 1ULL << 32u;
+constexpr uint64_t SERVICE_OFFSET = 2ULL << 32u;
+constexpr uint64_t CLIENT_OFFSET = 3ULL << 32u;
+/// notification id of IceoryxWaitSetOverflow::trigger_
+constexpr uint64_t OVERFLOW = UINT64_MAX;
+
+constexpr uint64_t SLOT_MASK = GUARD_CONDITION_OFFSET - 1u;
+
+inline uint64_t offset_of(uint64_t id)
+{
+  return id & ~SLOT_MASK;
+}
+
+inline uint64_t slot_of(uint64_t id)
+{
+  return id & SLOT_MASK;
+}
+}  // namespace notification_id
+
+/// How an entity is attached to a wait set
+enum class IceoryxAttachment
+{
+  /// not attached, rmw_wait polls the entities
+  NONE,
+  WAIT_SET,
+  /// attached to a listener which wakes up the WaitSet, see IceoryxWaitSetOverflow
+  LISTENER
+};
+
+/// Entities of one kind attached to a wait set, the slot of an entity is its notification id
+template<typename EntityT>
+struct IceoryxAttachments
+{
+  /// attached entity of each slot, nullptr for unused slots
+  std::vector<EntityT *> slots_;
+  /// true for slots whose entity is attached to a listener of IceoryxWaitSetOverflow
+  std::vector<bool> on_listener_;
+  /// index of the entity of each slot in the entity list passed to the last rmw_wait
+  std::vector<size_t> positions_;
+  /// entity list passed to the last rmw_wait
+  std::vector<void *> last_entities_;
+  /// true if the slots have to be compared with the entity list again
+  bool changed_{true};
+};
+
+/// @brief Attaches and detaches the difference between the attached and the requested entities
+/// @param attach called as attach(entity, slot) for a requested entity which is not attached,
+/// returns how it was attached
+/// @param detach called as detach(entity) for an attached entity which is not requested anymore
+/// @return false if an entity was not attached, it is attached again with the next call
+template<typename EntityT, typename AttachFunction, typename DetachFunction>
+bool update_attachment_slots(
+  IceoryxAttachments<EntityT> & attachments,
+  void * const * entities,
+  size_t count,
+  AttachFunction attach,
+  DetachFunction detach)
+{
+  auto & last_entities = attachments.last_entities_;
+  // in the steady state the entities are the same as in the last call
+  if (!attachments.changed_ && last_entities.size() == count &&
+    std::equal(last_entities.begin(), last_entities.end(), entities))
+  {
+    return true;
+  }
+
+  // requested entities which are not attached yet
+  std::unordered_map<const void *, size_t> requested;
+  requested.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    requested.emplace(entities[i], i);
+  }
+
+  auto & slots = attachments.slots_;
+  auto & positions = attachments.positions_;
+  std::vector<size_t> free_slots;
+  for (size_t slot = 0; slot < slots.size(); ++slot) {
+    if (!slots[slot]) {
+      free_slots.push_back(slot);
+      continue;
+    }
+    auto it = requested.find(slots[slot]);
+    if (it == requested.end()) {
+      detach(*slots[slot]);
+      slots[slot] = nullptr;
+      free_slots.push_back(slot);
+    } else {
+      positions[slot] = it->second;
+      requested.erase(it);
+    }
+  }
+
+  bool success{true};
+  for (size_t i = 0; i < count; ++i) {
+    auto it = requested.find(entities[i]);
+    if (it == requested.end() || it->second != i) {
+      continue;
+    }
+    auto entity = static_cast<EntityT *>(entities[i]);
+
+    size_t slot = slots.size();
+    if (free_slots.empty()) {
+      slots.push_back(nullptr);
+      positions.push_back(0u);
+      attachments.on_listener_.push_back(false);
+    } else {
+      slot = free_slots.back();
+      free_slots.pop_back();
+    }
+
+    auto attachment = attach(*entity, slot);
+    if (attachment != IceoryxAttachment::NONE) {
+      slots[slot] = entity;
+      positions[slot] = i;
+      attachments.on_listener_[slot] = (attachment == IceoryxAttachment::LISTENER);
+    } else {
+      free_slots.push_back(slot);
+      success = false;
+    }
+  }
+
+  last_entities.assign(entities, entities + count);
+  attachments.changed_ = !success;
+  return success;
+}
+
+/// @brief Puts the entity of a notification back into the entity list of rmw_wait
+template<typename EntityT>
+void mark_ready(const IceoryxAttachments<EntityT> & attachments, uint64_t slot, void ** entities)
+{
+  if (slot < attachments.slots_.size() && attachments.slots_[slot]) {
+    entities[attachments.positions_[slot]] = attachments.slots_[slot];
+  }
+}
+
+/// @brief Removes an entity from the slots without detaching it
+/// @return the entity, nullptr if it is not attached
+template<typename EntityT>
+EntityT * drop_attachment_slot(IceoryxAttachments<EntityT> & attachments, const void * entity)
+{
+  auto & slots = attachments.slots_;
+  auto it = std::find(slots.begin(), slots.end(), entity);
+  if (it == slots.end()) {
+    return nullptr;
+  }
+  auto dropped = *it;
+  *it = nullptr;
+  attachments.changed_ = true;
+  return dropped;
+}
+
+#endif  // TYPES__ICEORYX_ATTACHMENTS_HPP_
@@ -0,0 +1,59 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPES__ICEORYX_CLIENT_HPP_
+#define TYPES__ICEORYX_CLIENT_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "../iceoryx_generate_gid.hpp"
+#include "../iceoryx_service_messages.hpp"
+#include "./iceoryx_service.hpp"
+
+#include "iceoryx_posh/popo/untyped_publisher.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+
+#include "rmw/rmw.h"
+#include "rmw/types.h"
+
+struct IceoryxClient
+{
+  IceoryxClient(
+    const rosidl_message_type_support_t & request_type_supports,
+    const rosidl_message_type_support_t & response_type_supports,
+    iox::popo::UntypedPublisher * const iceoryx_sender)
+  : request_type_(request_type_supports),
+    response_type_(response_type_supports),
+    iceoryx_sender_(iceoryx_sender),
+    gid_(generate_publisher_gid(iceoryx_sender_))
+  {
+    memcpy(client_id_, gid_.data, CLIENT_ID_SIZE);
+  }
+
+  IceoryxServiceMessageType request_type_;
+  IceoryxServiceMessageType response_type_;
+  /// publishes the requests to the service
+  iox::popo::UntypedPublisher * const iceoryx_sender_;
+  /// subscribed to the response topic of this client, set after construction
+  iox::popo::UntypedSubscriber * iceoryx_receiver_{nullptr};
+  rmw_gid_t gid_;
+  /// writer guid of the requests, derived from the gid of the request publisher
+  int8_t client_id_[CLIENT_ID_SIZE];
+  /// sequence number of the last request sent
+  std::atomic<int64_t> sequence_number_{0};
+};
+
+#endif  // TYPES__ICEORYX_CLIENT_HPP_
@@ -0,0 +1,27 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPES__ICEORYX_CONTEXT_HPP_
+#define TYPES__ICEORYX_CONTEXT_HPP_
+
+#include "./iceoryx_node.hpp"
+
+/// Created by rmw_init after the runtime is registered with RouDi, destroyed by rmw_context_fini
+struct rmw_context_impl_t
+{
+  /// shared by all nodes of the context instead of a listener thread per node
+  IceoryxGraphChangeNotifier graph_change_notifier_;
+};
+
+#endif  // TYPES__ICEORYX_CONTEXT_HPP_
@@ -15,7 +15,12 @@
 #ifndef TYPES__ICEORYX_NODE_HPP_
 #define TYPES__ICEORYX_NODE_HPP_
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "iceoryx_posh/popo/untyped_subscriber.hpp"
 #include "iceoryx_posh/roudi/introspection_types.hpp"
@@ -23,10 +28,13 @@
 #include "iceoryx_posh/popo/listener.hpp"
 
 #include "rcutils/error_handling.h"
+#include "rcutils/get_env.h"
 
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
+
 #include "../iceoryx_identifier.hpp"
 #include "iceoryx_posh/popo/user_trigger.hpp"
 
@@ -35,62 +43,188 @@
 // does OFFER / STOP_OFFER or a receiver port comes or goes or does SUB / UNSUB
 /// @todo poehnl: check with the list of ros2 graph events
 
+/// One notifier is shared by all nodes of a context. A change of the graph triggers the graph
+/// guard condition of every node, or only of the nodes it affects if enabled with
+/// GRAPH_CHANGE_FILTERING_ENV_VAR, see GraphCache::GraphDelta
 class IceoryxGraphChangeNotifier
 {
 public:
-  explicit IceoryxGraphChangeNotifier(rmw_guard_condition_t * guard_condition)
+  IceoryxGraphChangeNotifier()
+  : filter_changes_(graph_change_filtering_enabled())
   {
-    if (!guard_condition || !guard_condition->data) {
-      RMW_SET_ERROR_MSG("invalid input for GraphChangeNotifier");
-      iceoryx_guard_condition_ = nullptr;
-    } else {
-      iceoryx_guard_condition_ = static_cast<iox::popo::UserTrigger *>(guard_condition->data);
-      RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
-        IceoryxGraphChangeNotifier
-        : guard_condition,
-        guard_condition->implementation_identifier,
-        rmw_get_implementation_identifier(),
-        iceoryx_guard_condition_ = nullptr);
-    }
-
     /// @todo change to the dds_common graph
     // subscribe with a callback for changes in the iceoryx graph
     // https://github.com/eclipse-iceoryx/iceoryx/issues/707
+    // the introspection delivers its latest sample on subscribe, so the graph cache is filled in
+    // the background right after rmw_init
     listener_.attachEvent(
       port_receiver_, iox::popo::SubscriberEvent::DATA_RECEIVED,
-      iox::popo::createNotificationCallback(IceoryxGraphChangeNotifier::callback, *this))
+      iox::popo::createNotificationCallback(IceoryxGraphChangeNotifier::port_callback, *this))
     .or_else(
       [](auto) {
         RMW_SET_ERROR_MSG("unable to attach port_receiver_");
         std::terminate();
       });
+    listener_.attachEvent(
+      process_receiver_, iox::popo::SubscriberEvent::DATA_RECEIVED,
+      iox::popo::createNotificationCallback(IceoryxGraphChangeNotifier::process_callback, *this))
+    .or_else(
+      [](auto) {
+        RMW_SET_ERROR_MSG("unable to attach process_receiver_");
+        std::terminate();
+      });
     port_receiver_.subscribe();
+    process_receiver_.subscribe();
   }
 
   ~IceoryxGraphChangeNotifier()
   {
     listener_.detachEvent(port_receiver_, iox::popo::SubscriberEvent::DATA_RECEIVED);
+    listener_.detachEvent(process_receiver_, iox::popo::SubscriberEvent::DATA_RECEIVED);
     port_receiver_.unsubscribe();
+    process_receiver_.unsubscribe();
+  }
+
+  /// @brief Triggers guard_condition on the changes of the graph until it is unregistered
+  /// @param node_full_name namespace and name of the node, as used for its iceoryx ports
+  /// @return RMW_RET_ERROR if guard_condition is not a valid iceoryx guard condition
+  rmw_ret_t register_guard_condition(
+    const rmw_guard_condition_t * guard_condition,
+    const std::string & node_full_name)
+  {
+    if (!guard_condition || !guard_condition->data) {
+      RMW_SET_ERROR_MSG("invalid input for GraphChangeNotifier");
+      return RMW_RET_ERROR;
+    }
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+      IceoryxGraphChangeNotifier
+      : guard_condition,
+      guard_condition->implementation_identifier,
+      rmw_get_implementation_identifier(),
+      return RMW_RET_ERROR);
+
+    auto node = rmw_iceoryx_cpp::intern_graph_name(node_full_name);
+    std::lock_guard<std::mutex> lock(mutex_);
+    iceoryx_guard_conditions_.push_back(
+      NodeGuardCondition{node, static_cast<iox::popo::UserTrigger *>(guard_condition->data)});
+    return RMW_RET_OK;
+  }
+
+  /// @brief Does nothing if guard_condition is not registered
+  void unregister_guard_condition(const rmw_guard_condition_t * guard_condition)
+  {
+    if (!guard_condition) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(
+      iceoryx_guard_conditions_.begin(), iceoryx_guard_conditions_.end(),
+      [guard_condition](const NodeGuardCondition & node_guard_condition) {
+        return node_guard_condition.trigger == guard_condition->data;
+      });
+    if (it != iceoryx_guard_conditions_.end()) {
+      iceoryx_guard_conditions_.erase(it);
+    }
   }
 
 private:
-  // must be a static method to be convertable to c function pointer
+  // must be static methods to be convertable to c function pointer
   // second argument (self) is the this pointer of the current object
-  static void callback(
+  static void port_callback(
     iox::popo::UntypedSubscriber * introspectionSubscriber,
     IceoryxGraphChangeNotifier * self)
   {
-    if (nullptr != self->iceoryx_guard_condition_) {
-      self->iceoryx_guard_condition_->trigger();
+    take_latest_sample<iox::roudi::PortIntrospectionFieldTopic>(introspectionSubscriber);
+    // the graph cache is up to date before the nodes are woken up
+    self->trigger_guard_conditions();
+  }
+
+  static void process_callback(
+    iox::popo::UntypedSubscriber * introspectionSubscriber,
+    IceoryxGraphChangeNotifier * self)
+  {
+    take_latest_sample<iox::roudi::ProcessIntrospectionFieldTopic>(introspectionSubscriber);
+    self->trigger_guard_conditions();
+  }
+
+  static bool graph_change_filtering_enabled()
+  {
+    const char * value = nullptr;
+    if (rcutils_get_env(rmw_iceoryx_cpp::GRAPH_CHANGE_FILTERING_ENV_VAR, &value) != nullptr) {
+      return false;
+    }
+    return value != nullptr && std::string(value) == "1";
+  }
+
+  /// @brief Applies the latest sample to the graph cache, older ones are dropped
+  template<typename SampleT>
+  static void take_latest_sample(iox::popo::UntypedSubscriber * introspectionSubscriber)
+  {
+    if (nullptr == introspectionSubscriber) {
+      return;
     }
-    if (nullptr != introspectionSubscriber) {
-      introspectionSubscriber->releaseQueuedData();
+    const void * previous_user_payload = nullptr;
+    while (introspectionSubscriber->take()
+      .and_then(
+        [&](const void * userPayload) {
+          if (previous_user_payload) {
+            introspectionSubscriber->release(previous_user_payload);
+          }
+          previous_user_payload = userPayload;
+        })
+      .or_else(
+        [](auto & result) {
+          if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
+            RMW_SET_ERROR_MSG("failed to take message");
+          }
+        }))
+    {
+    }
+
+    if (previous_user_payload) {
+      rmw_iceoryx_cpp::update_graph_cache(*static_cast<const SampleT *>(previous_user_payload));
+      introspectionSubscriber->release(previous_user_payload);
     }
   }
-  iox::popo::UserTrigger * iceoryx_guard_condition_{nullptr};
+
+  /// @brief Triggers the guard conditions for the changes since the last call
+  /// The graph cache is shared by the contexts of the process, the sample might have been applied
+  /// by the notifier of another context already.
+  void trigger_guard_conditions()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rmw_iceoryx_cpp::GraphCache::GraphDelta delta;
+    rmw_iceoryx_cpp::graph_delta_since(generation_, delta);
+    generation_ = delta.generation;
+    if (delta.empty() && !delta.affects_all_nodes) {
+      return;
+    }
+    for (auto & node_guard_condition : iceoryx_guard_conditions_) {
+      if (!filter_changes_ || delta.affects(node_guard_condition.node)) {
+        node_guard_condition.trigger->trigger();
+      }
+    }
+  }
+
+  struct NodeGuardCondition
+  {
+    /// full name of the node in the graph cache
+    rmw_iceoryx_cpp::GraphCache::Id node;
+    iox::popo::UserTrigger * trigger;
+  };
+
+  /// only trigger the nodes affected by a change, see GRAPH_CHANGE_FILTERING_ENV_VAR
+  const bool filter_changes_;
+  /// guards iceoryx_guard_conditions_ and generation_, locked by the listener callbacks
+  std::mutex mutex_;
+  std::vector<NodeGuardCondition> iceoryx_guard_conditions_;
+  /// generation of the graph cache up to which the changes were notified
+  uint64_t generation_{0u};
   using port_receiver_t = iox::popo::UntypedSubscriber;
   port_receiver_t port_receiver_{iox::roudi::IntrospectionPortService,
     iox::popo::SubscriberOptions{1U, 1U, "", true}};
+  port_receiver_t process_receiver_{iox::roudi::IntrospectionProcessService,
+    iox::popo::SubscriberOptions{1U, 1U, "", true}};
   using listener_t = iox::popo::Listener;
   listener_t listener_;
 };
@@ -107,6 +241,7 @@ struct IceoryxNodeInfo
   {
   }
   rmw_guard_condition_t * const guard_condition_;
+  /// owned by the context, see iceoryx_context.hpp
   IceoryxGraphChangeNotifier * const graph_change_notifier_;
   iox::runtime::Node * const iceoryx_runnable_;
 };
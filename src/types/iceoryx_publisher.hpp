@@ -16,6 +16,10 @@
 #ifndef TYPES__ICEORYX_PUBLISHER_HPP_
 #define TYPES__ICEORYX_PUBLISHER_HPP_
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
 #include "../iceoryx_generate_gid.hpp"
 
 #include "iceoryx_posh/popo/untyped_publisher.hpp"
@@ -23,6 +27,7 @@
 #include "rmw/rmw.h"
 #include "rmw/types.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_flat_message.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
 
 struct IceoryxPublisher
@@ -31,17 +36,38 @@ struct IceoryxPublisher
     const rosidl_message_type_support_t * type_supports,
     iox::popo::UntypedPublisher * const iceoryx_sender)
   : type_supports_(*type_supports),
+    type_info_(rmw_iceoryx_cpp::iceoryx_get_type_info(type_supports)),
     iceoryx_sender_(iceoryx_sender),
     gid_(generate_publisher_gid(iceoryx_sender_)),
-    is_fixed_size_(rmw_iceoryx_cpp::iceoryx_is_fixed_size(type_supports)),
-    message_size_(rmw_iceoryx_cpp::iceoryx_get_message_size(type_supports))
+    is_fixed_size_(type_info_.is_fixed_size),
+    message_size_(type_info_.size),
+    is_flat_(!is_fixed_size_ && rmw_iceoryx_cpp::iceoryx_is_flat_type(type_supports)),
+    flat_message_size_(
+      is_flat_ ? rmw_iceoryx_cpp::iceoryx_get_flat_message_size(type_supports) : 0u)
   {}
 
   rosidl_message_type_support_t type_supports_;
+  /// entry of the message type in the type registry
+  const rmw_iceoryx_cpp::TypeInfo & type_info_;
   iox::popo::UntypedPublisher * const iceoryx_sender_;
   rmw_gid_t gid_;
   bool is_fixed_size_;
   size_t message_size_;
+  /// bounded messages which are loaned with the flat layout
+  bool is_flat_;
+  size_t flat_message_size_;
+  /// messages which were neither serialized nor sent as there were no subscribers
+  std::atomic<uint64_t> skipped_publishes_{0u};
+  /// chunks which could not be loaned, e.g. as slow subscribers hold too many of them
+  std::atomic<uint64_t> failed_loans_{0u};
+  /// sequence number of the last message sent, see IceoryxUserHeader
+  std::atomic<uint64_t> sequence_number_{0u};
+};
+
+/// Serialization buffer which is reused by rmw_publish, so publishing does not allocate
+struct IceoryxPublisherAllocation
+{
+  std::vector<char> payload_vector_;
 };
 
 #endif  // TYPES__ICEORYX_PUBLISHER_HPP_
@@ -0,0 +1,96 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPES__ICEORYX_SERVICE_HPP_
+#define TYPES__ICEORYX_SERVICE_HPP_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "iceoryx_posh/popo/untyped_publisher.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+
+#include "rmw/rmw.h"
+#include "rmw/types.h"
+
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
+
+/// Request or response type of a service
+struct IceoryxServiceMessageType
+{
+  explicit IceoryxServiceMessageType(const rosidl_message_type_support_t & type_supports)
+  : type_supports_(type_supports),
+    type_info_(rmw_iceoryx_cpp::iceoryx_get_type_info(&type_supports_)),
+    is_fixed_size_(type_info_.is_fixed_size),
+    message_size_(type_info_.size)
+  {}
+
+  rosidl_message_type_support_t type_supports_;
+  /// entry of the message type in the type registry
+  const rmw_iceoryx_cpp::TypeInfo & type_info_;
+  /// fixed size messages are copied into the chunk instead of being serialized, not loaned
+  bool is_fixed_size_;
+  size_t message_size_;
+};
+
+/// Publisher of the responses to one client
+struct IceoryxResponseSender
+{
+  std::unique_ptr<iox::popo::UntypedPublisher> publisher_;
+  /// true once the subscriber of the client was connected, the sender is dropped when it is gone
+  bool had_subscriber_{false};
+  /// value of IceoryxService::response_count_ at the last response, for the LRU eviction
+  uint64_t last_response_{0u};
+};
+
+/// Requests are received on a single topic per service, each client gets its own response topic
+struct IceoryxService
+{
+  IceoryxService(
+    const rosidl_message_type_support_t & request_type_supports,
+    const rosidl_message_type_support_t & response_type_supports,
+    iox::popo::UntypedSubscriber * const iceoryx_receiver,
+    const std::string & service_name,
+    const std::string & node_full_name,
+    uint64_t response_history)
+  : request_type_(request_type_supports),
+    response_type_(response_type_supports),
+    iceoryx_receiver_(iceoryx_receiver),
+    service_name_(service_name),
+    node_full_name_(node_full_name),
+    response_history_(response_history)
+  {}
+
+  IceoryxServiceMessageType request_type_;
+  IceoryxServiceMessageType response_type_;
+  iox::popo::UntypedSubscriber * const iceoryx_receiver_;
+  std::string service_name_;
+  std::string node_full_name_;
+  /// history of the response publishers, the responses to all requests a client has in flight
+  /// before its subscriber is connected are delivered
+  uint64_t response_history_;
+  /// at most this many response publishers are kept, the least recently used one is dropped
+  static constexpr size_t MAX_RESPONSE_SENDERS = 64u;
+  /// guards response_senders_ and response_count_
+  std::mutex response_senders_mutex_;
+  /// response publisher of each client, created with the first response to the client and
+  /// dropped when the client is gone
+  std::map<std::string, IceoryxResponseSender> response_senders_;
+  uint64_t response_count_{0u};
+};
+
+#endif  // TYPES__ICEORYX_SERVICE_HPP_
@@ -15,28 +15,113 @@
 #ifndef TYPES__ICEORYX_SUBSCRIPTION_HPP_
 #define TYPES__ICEORYX_SUBSCRIPTION_HPP_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 #include "iceoryx_posh/popo/untyped_subscriber.hpp"
 
 #include "rmw/rmw.h"
 #include "rmw/types.h"
 
+#include "rmw_iceoryx_cpp/iceoryx_deserialize.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_latency_histogram.hpp"
 #include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
 
+/// Last sequence number taken from one publisher
+struct IceoryxPublisherSequence
+{
+  std::array<uint8_t, RMW_GID_STORAGE_SIZE> publisher_gid_{};
+  uint64_t last_sequence_number_{0u};
+  /// value of IceoryxPublisherSequences::taken_chunk_count_ at the last take, for the LRU eviction
+  uint64_t last_take_{0u};
+};
+
+/// Last sequence number taken from each publisher of a subscription, a gap means messages were lost
+struct IceoryxPublisherSequences
+{
+  /// at most this many publishers are tracked, the least recently taken from one is replaced
+  static constexpr size_t MAX_TRACKED_PUBLISHERS = 16u;
+  std::array<IceoryxPublisherSequence, MAX_TRACKED_PUBLISHERS> publishers_;
+  uint64_t taken_chunk_count_{0u};
+};
+
+/// @brief Records the sequence number of a chunk taken from a publisher
+/// The sequence numbers of a publisher are consecutive, the subscriber queue discards the oldest
+/// chunks when it overflows.
+/// @return the number of messages of the publisher lost since the last chunk taken from it
+inline uint64_t record_publisher_sequence(
+  IceoryxPublisherSequences & sequences,
+  const uint8_t * publisher_gid,
+  uint64_t sequence_number)
+{
+  IceoryxPublisherSequence * publisher_sequence = nullptr;
+  IceoryxPublisherSequence * least_recent = &sequences.publishers_.front();
+  for (auto & candidate : sequences.publishers_) {
+    if (memcmp(candidate.publisher_gid_.data(), publisher_gid, RMW_GID_STORAGE_SIZE) == 0) {
+      publisher_sequence = &candidate;
+      break;
+    }
+    if (candidate.last_take_ < least_recent->last_take_) {
+      least_recent = &candidate;
+    }
+  }
+  if (!publisher_sequence) {
+    // the gap of a replaced publisher is not counted when it is tracked again
+    publisher_sequence = least_recent;
+    memcpy(publisher_sequence->publisher_gid_.data(), publisher_gid, RMW_GID_STORAGE_SIZE);
+    publisher_sequence->last_sequence_number_ = 0u;
+  }
+
+  const uint64_t last_sequence_number = publisher_sequence->last_sequence_number_;
+  uint64_t lost{0u};
+  if (last_sequence_number != 0u && sequence_number > last_sequence_number + 1u) {
+    lost = sequence_number - last_sequence_number - 1u;
+  }
+  publisher_sequence->last_sequence_number_ = sequence_number;
+  publisher_sequence->last_take_ = ++sequences.taken_chunk_count_;
+  return lost;
+}
+
 struct IceoryxSubscription
 {
   IceoryxSubscription(
     const rosidl_message_type_support_t * type_supports,
     iox::popo::UntypedSubscriber * const iceoryx_receiver)
   : type_supports_(*type_supports),
+    type_info_(rmw_iceoryx_cpp::iceoryx_get_type_info(type_supports)),
     iceoryx_receiver_(iceoryx_receiver),
-    is_fixed_size_(rmw_iceoryx_cpp::iceoryx_is_fixed_size(type_supports)),
-    message_size_(rmw_iceoryx_cpp::iceoryx_get_message_size(type_supports))
+    is_fixed_size_(type_info_.is_fixed_size),
+    message_size_(type_info_.size)
   {}
 
   rosidl_message_type_support_t type_supports_;
+  /// entry of the message type in the type registry
+  const rmw_iceoryx_cpp::TypeInfo & type_info_;
   iox::popo::UntypedSubscriber * const iceoryx_receiver_;
   bool is_fixed_size_;
   size_t message_size_;
+  /// number of messages taken so far, reported as reception sequence number
+  uint64_t reception_sequence_number_{0u};
+  /// publish-to-take latencies, null unless enabled with LATENCY_STATISTICS_ENV_VAR
+  std::unique_ptr<rmw_iceoryx_cpp::LatencyHistogram> latency_histogram_;
+  IceoryxPublisherSequences publisher_sequences_;
+  /// messages lost so far, reported by rmw_take_event as RMW_EVENT_MESSAGE_LOST
+  std::atomic<uint64_t> lost_message_count_{0u};
+  /// lost_message_count_ at the last rmw_take_event
+  std::atomic<uint64_t> reported_lost_message_count_{0u};
+};
+
+/// Buffers which are reused by rmw_take, so taking into a reused message does not allocate
+struct IceoryxSubscriptionAllocation
+{
+  /// flat messages are converted to the serialized format before deserialization
+  std::vector<char> payload_vector_;
+  /// bounded fields of the message type, rmw_take presizes the message with them
+  rmw_iceoryx_cpp::ReservePlan reserve_plan_;
 };
 
 #endif  // TYPES__ICEORYX_SUBSCRIPTION_HPP_
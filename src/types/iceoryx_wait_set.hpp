@@ -0,0 +1,151 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPES__ICEORYX_WAIT_SET_HPP_
+#define TYPES__ICEORYX_WAIT_SET_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "iceoryx_posh/popo/listener.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+#include "iceoryx_posh/popo/user_trigger.hpp"
+#include "iceoryx_posh/popo/wait_set.hpp"
+
+#include "./iceoryx_attachments.hpp"
+#include "./iceoryx_client.hpp"
+#include "./iceoryx_service.hpp"
+#include "./iceoryx_subscription.hpp"
+
+/// The iceoryx WaitSet of a wait set, whose capacity is a template parameter
+class IceoryxWaitSetBackend
+{
+public:
+  virtual ~IceoryxWaitSetBackend() = default;
+
+  /// @return false if the WaitSet is full
+  virtual bool attach(
+    iox::popo::UntypedSubscriber & iceoryx_receiver,
+    uint64_t notification_id) = 0;
+  virtual bool attach(iox::popo::UserTrigger & iceoryx_trigger, uint64_t notification_id) = 0;
+  virtual void detach(iox::popo::UntypedSubscriber & iceoryx_receiver) = 0;
+  virtual void detach(iox::popo::UserTrigger & iceoryx_trigger) = 0;
+
+  /// @brief Blocks until an attachment is notified or the timeout elapsed
+  /// @param timeout nullptr to block without timeout
+  /// @param[out] notification_ids the ids of the notified attachments, reserved to the capacity
+  virtual void wait(
+    const iox::units::Duration * timeout,
+    std::vector<uint64_t> & notification_ids) = 0;
+
+  virtual uint64_t capacity() const = 0;
+};
+
+/// @brief Creates the WaitSet with the smallest capacity which holds max_conditions and the
+/// overflow trigger, the largest one if max_conditions is 0 (unbounded)
+std::unique_ptr<IceoryxWaitSetBackend> make_iceoryx_wait_set_backend(size_t max_conditions);
+
+/// Entities which do not fit into the iceoryx WaitSet are attached to listeners of the listener
+/// pool instead, which wake up the WaitSet through a single user trigger
+struct IceoryxWaitSetOverflow
+{
+  /// attached to the WaitSet with notification_id::OVERFLOW
+  iox::popo::UserTrigger trigger_;
+  /// guards triggered_guard_conditions_, locked by the listener callbacks
+  std::mutex triggered_mutex_;
+  /// guard conditions on a listener which were triggered since the last rmw_wait
+  std::unordered_set<const void *> triggered_guard_conditions_;
+  /// guards attached_, never locked by the listener callbacks
+  std::mutex mutex_;
+  /// listener each entity is attached to, the entities are detached before the wait set is
+  /// destroyed because the listeners outlive it
+  std::unordered_map<const void *, iox::popo::Listener *> attached_;
+};
+
+/// Requests of other threads to a wait set, guarded by the mutex of the attachment registry
+struct IceoryxAttachmentRequests
+{
+  /// true while a thread is inside rmw_wait with the wait set
+  bool in_wait_{false};
+  /// entities the wait set has to detach when leaving rmw_wait
+  std::vector<const void *> releases_;
+};
+
+/// The entities stay attached to the iceoryx WaitSet between the calls of rmw_wait, only the
+/// difference to the entities of the previous call is attached or detached
+struct IceoryxWaitSet
+{
+  std::unique_ptr<IceoryxWaitSetBackend> waitset_;
+  /// filled by IceoryxWaitSetBackend::wait, reserved once
+  std::vector<uint64_t> notification_ids_;
+  IceoryxWaitSetOverflow overflow_;
+  IceoryxAttachments<IceoryxSubscription> subscriptions_;
+  IceoryxAttachments<iox::popo::UserTrigger> guard_conditions_;
+  IceoryxAttachments<IceoryxService> services_;
+  IceoryxAttachments<IceoryxClient> clients_;
+  IceoryxAttachmentRequests requests_;
+  /// rmw_wait busy-polls the subscriptions this long before it blocks, see iceoryx_wait_spin.hpp
+  std::atomic<uint64_t> spin_duration_ns_{0u};
+  std::atomic<uint64_t> spin_count_{0u};
+  std::atomic<uint64_t> spin_success_count_{0u};
+};
+
+/// An entity can only be attached to a single iceoryx WaitSet or listener. A registry records
+/// which wait set holds an entity. Only the thread inside rmw_wait touches the WaitSet of a wait
+/// set, other threads detach entities from a wait set while no thread is inside rmw_wait with it
+/// or ask it to detach them when it leaves rmw_wait.
+
+enum class IceoryxAcquireResult
+{
+  ACQUIRED,
+  /// a wait set inside rmw_wait holds the entity, it is woken up and releases it
+  HELD_ELSEWHERE,
+  /// the entity is attached to the listener of its event fd, see iceoryx_event_fd.hpp
+  EVENT_FD
+};
+
+/// @brief Records that wait_set attaches entity
+/// A wait set outside of rmw_wait which holds the entity has it detached right away.
+IceoryxAcquireResult acquire_attachment(const void * entity, IceoryxWaitSet * wait_set);
+
+/// @brief Records that wait_set detached entity
+void release_attachment(const void * entity, const IceoryxWaitSet * wait_set);
+
+/// @brief Detaches entity from the wait set holding it, to be called before it is destroyed
+/// Blocks until a wait set inside rmw_wait released the entity.
+void take_from_wait_set(const void * entity);
+
+/// @brief Takes entity from the wait set holding it for its event fd, wait sets can't attach it
+/// until return_from_event_fd is called
+void take_for_event_fd(const void * entity);
+void return_from_event_fd(const void * entity);
+
+/// @brief Called when entering and leaving rmw_wait, detaches the entities other threads asked for
+void enter_wait(IceoryxWaitSet * wait_set);
+void leave_wait(IceoryxWaitSet * wait_set);
+
+/// @brief Detaches all entities of a wait set, to be called before it is destroyed
+void release_attachments(IceoryxWaitSet * wait_set);
+
+/// @brief Detaches an entity from the WaitSet or a listener of a wait set and frees its slot
+/// @return false if the wait set does not have the entity attached
+bool drop_attachment(IceoryxWaitSet & wait_set, const void * entity);
+
+#endif  // TYPES__ICEORYX_WAIT_SET_HPP_
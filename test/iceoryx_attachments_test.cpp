@@ -0,0 +1,203 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "types/iceoryx_attachments.hpp"
+
+namespace
+{
+struct Entity
+{
+  int id;
+};
+
+/// records the calls of update_attachment_slots, the attach result is configurable
+class AttachmentsTests : public ::testing::Test
+{
+protected:
+  bool update(void * const * entities, size_t count)
+  {
+    attached_.clear();
+    detached_.clear();
+    return update_attachment_slots(
+      attachments_, entities, count,
+      [this](Entity & entity, size_t slot) {
+        attached_.push_back({&entity, slot});
+        return attach_result_;
+      },
+      [this](Entity & entity) {
+        detached_.push_back(&entity);
+      });
+  }
+
+  std::array<Entity, 4> entities_{{{0}, {1}, {2}, {3}}};
+  IceoryxAttachments<Entity> attachments_;
+  IceoryxAttachment attach_result_{IceoryxAttachment::WAIT_SET};
+  std::vector<std::pair<Entity *, size_t>> attached_;
+  std::vector<Entity *> detached_;
+};
+}  // namespace
+
+TEST_F(AttachmentsTests, first_update_attaches_all_entities)
+{
+  void * entities[] = {&entities_[0], &entities_[1], &entities_[2]};
+  EXPECT_TRUE(update(entities, 3u));
+  ASSERT_EQ(3u, attached_.size());
+  EXPECT_TRUE(detached_.empty());
+  for (size_t i = 0; i < attached_.size(); ++i) {
+    EXPECT_EQ(&entities_[i], attached_[i].first);
+    EXPECT_EQ(i, attached_[i].second);
+    EXPECT_EQ(&entities_[i], attachments_.slots_[i]);
+    EXPECT_EQ(i, attachments_.positions_[i]);
+  }
+}
+
+TEST_F(AttachmentsTests, unchanged_entities_are_not_attached_again)
+{
+  void * entities[] = {&entities_[0], &entities_[1]};
+  EXPECT_TRUE(update(entities, 2u));
+  EXPECT_TRUE(update(entities, 2u));
+  EXPECT_TRUE(attached_.empty());
+  EXPECT_TRUE(detached_.empty());
+}
+
+TEST_F(AttachmentsTests, only_the_difference_is_attached_and_detached)
+{
+  void * first[] = {&entities_[0], &entities_[1], &entities_[2]};
+  EXPECT_TRUE(update(first, 3u));
+
+  // entity 1 is gone, entity 3 is new and reuses the slot of entity 1
+  void * second[] = {&entities_[2], &entities_[3], &entities_[0]};
+  EXPECT_TRUE(update(second, 3u));
+  ASSERT_EQ(1u, detached_.size());
+  EXPECT_EQ(&entities_[1], detached_[0]);
+  ASSERT_EQ(1u, attached_.size());
+  EXPECT_EQ(&entities_[3], attached_[0].first);
+  EXPECT_EQ(1u, attached_[0].second);
+
+  // the positions follow the new order of the entity list
+  EXPECT_EQ(2u, attachments_.positions_[0]);
+  EXPECT_EQ(1u, attachments_.positions_[1]);
+  EXPECT_EQ(0u, attachments_.positions_[2]);
+}
+
+TEST_F(AttachmentsTests, reordered_entities_are_not_attached_again)
+{
+  void * first[] = {&entities_[0], &entities_[1]};
+  EXPECT_TRUE(update(first, 2u));
+  void * second[] = {&entities_[1], &entities_[0]};
+  EXPECT_TRUE(update(second, 2u));
+  EXPECT_TRUE(attached_.empty());
+  EXPECT_TRUE(detached_.empty());
+  EXPECT_EQ(1u, attachments_.positions_[0]);
+  EXPECT_EQ(0u, attachments_.positions_[1]);
+}
+
+TEST_F(AttachmentsTests, empty_entity_list_detaches_all)
+{
+  void * entities[] = {&entities_[0], &entities_[1]};
+  EXPECT_TRUE(update(entities, 2u));
+  EXPECT_TRUE(update(nullptr, 0u));
+  EXPECT_EQ(2u, detached_.size());
+  EXPECT_EQ(nullptr, attachments_.slots_[0]);
+  EXPECT_EQ(nullptr, attachments_.slots_[1]);
+}
+
+TEST_F(AttachmentsTests, failed_attach_is_retried_with_the_next_update)
+{
+  void * entities[] = {&entities_[0]};
+  attach_result_ = IceoryxAttachment::NONE;
+  EXPECT_FALSE(update(entities, 1u));
+  EXPECT_EQ(nullptr, attachments_.slots_[0]);
+
+  attach_result_ = IceoryxAttachment::WAIT_SET;
+  EXPECT_TRUE(update(entities, 1u));
+  ASSERT_EQ(1u, attached_.size());
+  EXPECT_EQ(&entities_[0], attachments_.slots_[0]);
+}
+
+TEST_F(AttachmentsTests, listener_attachments_are_flagged)
+{
+  void * entities[] = {&entities_[0]};
+  attach_result_ = IceoryxAttachment::LISTENER;
+  EXPECT_TRUE(update(entities, 1u));
+  EXPECT_TRUE(attachments_.on_listener_[0]);
+}
+
+TEST_F(AttachmentsTests, dropped_slot_is_attached_again)
+{
+  void * entities[] = {&entities_[0], &entities_[1]};
+  EXPECT_TRUE(update(entities, 2u));
+
+  // another wait set took entity 1, it is not detached here
+  EXPECT_EQ(&entities_[1], drop_attachment_slot(attachments_, &entities_[1]));
+  EXPECT_EQ(nullptr, drop_attachment_slot(attachments_, &entities_[1]));
+  EXPECT_EQ(nullptr, attachments_.slots_[1]);
+
+  // the same entity list attaches it again
+  EXPECT_TRUE(update(entities, 2u));
+  EXPECT_TRUE(detached_.empty());
+  ASSERT_EQ(1u, attached_.size());
+  EXPECT_EQ(&entities_[1], attached_[0].first);
+}
+
+TEST(NotificationIdTests, offset_and_slot_are_decoded)
+{
+  const uint64_t offsets[] = {
+    notification_id::SUBSCRIPTION_OFFSET, notification_id::GUARD_CONDITION_OFFSET,
+    notification_id::SERVICE_OFFSET, notification_id::CLIENT_OFFSET};
+  const uint64_t slots[] = {0u, 1u, 42u, notification_id::SLOT_MASK};
+  for (auto offset : offsets) {
+    for (auto slot : slots) {
+      EXPECT_EQ(offset, notification_id::offset_of(offset + slot));
+      EXPECT_EQ(slot, notification_id::slot_of(offset + slot));
+    }
+  }
+}
+
+TEST(NotificationIdTests, overflow_is_no_entity_kind)
+{
+  const auto offset = notification_id::offset_of(notification_id::OVERFLOW);
+  EXPECT_NE(notification_id::SUBSCRIPTION_OFFSET, offset);
+  EXPECT_NE(notification_id::GUARD_CONDITION_OFFSET, offset);
+  EXPECT_NE(notification_id::SERVICE_OFFSET, offset);
+  EXPECT_NE(notification_id::CLIENT_OFFSET, offset);
+}
+
+TEST_F(AttachmentsTests, notified_slot_is_marked_ready_at_its_position)
+{
+  void * first[] = {&entities_[0], &entities_[1], &entities_[2]};
+  EXPECT_TRUE(update(first, 3u));
+  void * second[] = {&entities_[2], &entities_[1], &entities_[0]};
+  EXPECT_TRUE(update(second, 3u));
+
+  // rmw_wait clears the entity list and puts the notified entities back
+  void * ready[] = {nullptr, nullptr, nullptr};
+  const uint64_t id = notification_id::SERVICE_OFFSET + 2u;
+  mark_ready(attachments_, notification_id::slot_of(id), ready);
+  EXPECT_EQ(&entities_[2], ready[0]);
+  EXPECT_EQ(nullptr, ready[1]);
+  EXPECT_EQ(nullptr, ready[2]);
+
+  // unknown and freed slots are ignored
+  mark_ready(attachments_, 7u, ready);
+  drop_attachment_slot(attachments_, &entities_[1]);
+  mark_ready(attachments_, 1u, ready);
+  EXPECT_EQ(nullptr, ready[1]);
+}
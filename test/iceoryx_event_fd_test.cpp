@@ -0,0 +1,110 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_iceoryx_cpp/iceoryx_event_fd.hpp"
+
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include "iceoryx_posh/runtime/posh_runtime.hpp"
+#include "testutils/roudi_gtest.hpp"
+
+#include "rmw/error_handling.h"
+#include "rmw/init.h"
+#include "rmw/rmw.h"
+
+/// the guard conditions and wait sets are created through the rmw API against a RouDi of the test
+class EventFdTests : public RouDi_GTest
+{
+protected:
+  void SetUp() override
+  {
+    iox::runtime::PoshRuntime::initRuntime("event_fd_test");
+    context_.implementation_identifier = rmw_get_implementation_identifier();
+    guard_condition_ = rmw_create_guard_condition(&context_);
+    ASSERT_NE(nullptr, guard_condition_);
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RMW_RET_OK, rmw_destroy_guard_condition(guard_condition_));
+    rmw_reset_error();
+  }
+
+  /// @return true if fd becomes readable within timeout_ms
+  static bool readable(int fd, int timeout_ms)
+  {
+    pollfd poll_fd{fd, POLLIN, 0};
+    return poll(&poll_fd, 1u, timeout_ms) == 1 && (poll_fd.revents & POLLIN);
+  }
+
+  rmw_context_t context_ = rmw_get_zero_initialized_context();
+  rmw_guard_condition_t * guard_condition_{nullptr};
+};
+
+TEST_F(EventFdTests, fd_is_readable_after_trigger)
+{
+  int fd = -1;
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_guard_condition_event_fd(guard_condition_, &fd));
+  ASSERT_GE(fd, 0);
+  EXPECT_FALSE(readable(fd, 0));
+
+  ASSERT_EQ(RMW_RET_OK, rmw_trigger_guard_condition(guard_condition_));
+  EXPECT_TRUE(readable(fd, 1000));
+
+  // reading resets the fd
+  eventfd_t value = 0u;
+  EXPECT_EQ(0, eventfd_read(fd, &value));
+  EXPECT_FALSE(readable(fd, 0));
+
+  // the same fd is handed out again
+  int same_fd = -1;
+  ASSERT_EQ(
+    RMW_RET_OK, rmw_iceoryx_cpp::get_guard_condition_event_fd(guard_condition_, &same_fd));
+  EXPECT_EQ(fd, same_fd);
+}
+
+TEST_F(EventFdTests, rmw_wait_rejects_entity_with_event_fd)
+{
+  auto wait_set = rmw_create_wait_set(&context_, 1u);
+  ASSERT_NE(nullptr, wait_set);
+
+  void * guard_condition_data[] = {guard_condition_->data};
+  rmw_guard_conditions_t guard_conditions{1u, guard_condition_data};
+  rmw_subscriptions_t subscriptions{0u, nullptr};
+  rmw_services_t services{0u, nullptr};
+  rmw_clients_t clients{0u, nullptr};
+  rmw_events_t events{0u, nullptr};
+  rmw_time_t timeout{0u, 0u};
+
+  // the wait set which holds the guard condition gives it up for the event fd
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_wait(&subscriptions, &guard_conditions, &services, &clients, &events, wait_set, &timeout));
+
+  int fd = -1;
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_guard_condition_event_fd(guard_condition_, &fd));
+
+  guard_condition_data[0] = guard_condition_->data;
+  EXPECT_EQ(
+    RMW_RET_ERROR,
+    rmw_wait(&subscriptions, &guard_conditions, &services, &clients, &events, wait_set, &timeout));
+  rmw_reset_error();
+
+  ASSERT_EQ(RMW_RET_OK, rmw_trigger_guard_condition(guard_condition_));
+  EXPECT_TRUE(readable(fd, 1000));
+
+  EXPECT_EQ(RMW_RET_OK, rmw_destroy_wait_set(wait_set));
+}
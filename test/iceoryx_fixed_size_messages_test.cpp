@@ -16,6 +16,9 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
 
 #include "test_msgs/message_fixtures.hpp"
@@ -109,3 +112,50 @@ TEST(FixedSizeMessagesTest, test_cache_behavior_c)
   ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, MultiNested);
   EXPECT_FALSE(is_fixed_size(ts));
 }
+
+TEST(FixedSizeMessagesTest, test_type_registry)
+{
+  auto ts_cpp = rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Nested>();
+  auto ts_c = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Nested);
+
+  auto & type_info_cpp = rmw_iceoryx_cpp::iceoryx_get_type_info(ts_cpp);
+  EXPECT_EQ(rmw_iceoryx_cpp::TypeSupportLanguage::CPP, type_info_cpp.language);
+  EXPECT_TRUE(type_info_cpp.is_fixed_size);
+  EXPECT_EQ(sizeof(test_msgs::msg::Nested), type_info_cpp.size);
+  EXPECT_EQ("Nested", type_info_cpp.name);
+
+  auto & type_info_c = rmw_iceoryx_cpp::iceoryx_get_type_info(ts_c);
+  EXPECT_EQ(rmw_iceoryx_cpp::TypeSupportLanguage::C, type_info_c.language);
+  EXPECT_EQ(sizeof(test_msgs__msg__Nested), type_info_c.size);
+
+  // entries are resolved once, copies of a type support handle share the entry
+  auto ts_copy = *ts_cpp;
+  EXPECT_EQ(&type_info_cpp, &rmw_iceoryx_cpp::iceoryx_get_type_info(ts_cpp));
+  EXPECT_EQ(&type_info_cpp, &rmw_iceoryx_cpp::iceoryx_get_type_info(&ts_copy));
+  EXPECT_EQ(
+    &type_info_cpp,
+    &rmw_iceoryx_cpp::iceoryx_get_type_info(type_info_cpp.introspection_type_supports));
+  EXPECT_NE(&type_info_cpp, &type_info_c);
+}
+
+TEST(FixedSizeMessagesTest, test_type_registry_concurrent)
+{
+  auto ts = rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Strings>();
+
+  std::vector<const rmw_iceoryx_cpp::TypeInfo *> type_infos(8u, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < type_infos.size(); ++i) {
+    threads.emplace_back(
+      [&type_infos, ts, i]() {
+        type_infos[i] = &rmw_iceoryx_cpp::iceoryx_get_type_info(ts);
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  for (auto type_info : type_infos) {
+    EXPECT_EQ(type_infos.front(), type_info);
+    EXPECT_FALSE(type_info->is_fixed_size);
+  }
+}
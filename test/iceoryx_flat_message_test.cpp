@@ -0,0 +1,86 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_iceoryx_cpp/iceoryx_deserialize.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_flat_message.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/msg/bounded_plain_sequences.h"
+#include "test_msgs/msg/bounded_plain_sequences.hpp"
+
+#include "./test_msgs_c_fixtures.hpp"
+
+TEST(FlatMessageTest, test_flat_types_c)
+{
+  auto ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BoundedPlainSequences);
+  EXPECT_TRUE(rmw_iceoryx_cpp::iceoryx_is_flat_type(ts));
+
+  // unbounded strings or sequences
+  ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings);
+  EXPECT_FALSE(rmw_iceoryx_cpp::iceoryx_is_flat_type(ts));
+  ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BoundedSequences);
+  EXPECT_FALSE(rmw_iceoryx_cpp::iceoryx_is_flat_type(ts));
+  ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, UnboundedSequences);
+  EXPECT_FALSE(rmw_iceoryx_cpp::iceoryx_is_flat_type(ts));
+}
+
+TEST(FlatMessageTest, test_flat_types_cpp)
+{
+  // std::vector can't be placed in a chunk
+  auto ts = rosidl_typesupport_cpp::get_message_type_support_handle<
+    test_msgs::msg::BoundedPlainSequences>();
+  EXPECT_FALSE(rmw_iceoryx_cpp::iceoryx_is_flat_type(ts));
+}
+
+TEST(FlatMessageTest, test_flat_to_cpp)
+{
+  auto ts_c = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BoundedPlainSequences);
+  auto ts_cpp = rosidl_typesupport_cpp::get_message_type_support_handle<
+    test_msgs::msg::BoundedPlainSequences>();
+
+  // the flat size is independent of the language
+  auto flat_size = rmw_iceoryx_cpp::iceoryx_get_flat_message_size(ts_c);
+  ASSERT_EQ(flat_size, rmw_iceoryx_cpp::iceoryx_get_flat_message_size(ts_cpp));
+
+  std::vector<uint64_t> chunk(flat_size / sizeof(uint64_t) + 1u);
+  rmw_iceoryx_cpp::iceoryx_init_flat_message(ts_c, chunk.data());
+
+  auto msg = reinterpret_cast<test_msgs__msg__BoundedPlainSequences *>(chunk.data());
+  ASSERT_EQ(3u, msg->int32_values.capacity);
+  msg->int32_values.size = 2;
+  msg->int32_values.data[0] = 42;
+  msg->int32_values.data[1] = -23;
+  msg->basic_types_values.size = 1;
+  msg->basic_types_values.data[0].uint64_value = 1337u;
+  msg->alignment_check = 7;
+
+  rmw_iceoryx_cpp::iceoryx_relocate_flat_message(ts_c, chunk.data());
+
+  std::vector<char> serialized_msg{};
+  rmw_iceoryx_cpp::iceoryx_flat_to_serialized(chunk.data(), flat_size, ts_cpp, serialized_msg);
+
+  test_msgs::msg::BoundedPlainSequences cpp_msg{};
+  rmw_iceoryx_cpp::deserialize(serialized_msg.data(), ts_cpp, &cpp_msg);
+  ASSERT_EQ(2u, cpp_msg.int32_values.size());
+  EXPECT_EQ(42, cpp_msg.int32_values[0]);
+  EXPECT_EQ(-23, cpp_msg.int32_values[1]);
+  ASSERT_EQ(1u, cpp_msg.basic_types_values.size());
+  EXPECT_EQ(1337u, cpp_msg.basic_types_values[0].uint64_value);
+  EXPECT_EQ(7, cpp_msg.alignment_check);
+}
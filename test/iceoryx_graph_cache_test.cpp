@@ -0,0 +1,375 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_iceoryx_cpp/iceoryx_graph_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "iceoryx_posh/roudi/introspection_types.hpp"
+
+template<typename PortDataT>
+PortDataT make_port(const std::string & node, const std::string & topic, const std::string & type)
+{
+  // ROS 2 naming, see iceoryx_name_conversion.hpp
+  PortDataT port;
+  port.m_node = iox::NodeName_t(iox::cxx::TruncateToCapacity, node);
+  port.m_caproServiceID = iox::capro::IdString_t(iox::cxx::TruncateToCapacity, type);
+  port.m_caproInstanceID = iox::capro::IdString_t(iox::cxx::TruncateToCapacity, topic);
+  port.m_caproEventMethodID = iox::capro::IdString_t(iox::cxx::TruncateToCapacity, "data");
+  return port;
+}
+
+TEST(GraphCacheTests, update)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+  EXPECT_EQ(0u, graph_cache.generation());
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>("/ns/talker", "/chatter", "std_msgs/msg/String"));
+  port_sample.m_publisherList.back().m_publisherPortID = 42u;
+  port_sample.m_subscriberList.push_back(
+    make_port<iox::roudi::SubscriberPortData>("/ns/listener", "/chatter", "std_msgs/msg/String"));
+  port_sample.m_subscriberList.push_back(
+    make_port<iox::roudi::SubscriberPortData>("/ns/other", "/chatter", "std_msgs/msg/String"));
+  graph_cache.update(port_sample);
+  EXPECT_EQ(1u, graph_cache.generation());
+
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      ASSERT_EQ(1u, graph.topics.size());
+      auto topic = graph.find_topic("/chatter");
+      ASSERT_NE(nullptr, topic);
+      EXPECT_EQ("std_msgs/msg/String", graph.names.name(topic->type));
+      EXPECT_EQ(1u, topic->publishers.size());
+      EXPECT_EQ(2u, topic->subscribers.size());
+      EXPECT_EQ(42u, topic->publishers.front().port_id);
+      auto node = graph.find_node("/ns/talker");
+      ASSERT_NE(nullptr, node);
+      EXPECT_EQ("/chatter", graph.names.name(node->publishers.front()));
+      EXPECT_EQ("talker", graph.names.name(node->name));
+      EXPECT_EQ("/ns", graph.names.name(node->namespace_));
+    });
+  EXPECT_EQ(1u, graph_cache.count_publishers("/chatter"));
+  EXPECT_EQ(2u, graph_cache.count_subscribers("/chatter"));
+  EXPECT_EQ(0u, graph_cache.count_publishers("/unknown"));
+
+  // a sample replaces the whole graph
+  port_sample.m_subscriberList.clear();
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>("/ns/talker", "/chatter", "std_msgs/msg/String"));
+  port_sample.m_publisherList.back().m_publisherPortID = 43u;
+  graph_cache.update(port_sample);
+  EXPECT_EQ(2u, graph_cache.generation());
+
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      auto topic = graph.find_topic("/chatter");
+      ASSERT_NE(nullptr, topic);
+      EXPECT_TRUE(topic->subscribers.empty());
+      EXPECT_EQ(2u, topic->publishers.size());
+      EXPECT_EQ(nullptr, graph.find_node("/ns/listener"));
+    });
+  EXPECT_EQ(2u, graph_cache.count_publishers("/chatter"));
+  EXPECT_EQ(0u, graph_cache.count_subscribers("/chatter"));
+
+  // topics without any endpoint are dropped
+  port_sample.m_publisherList.clear();
+  graph_cache.update(port_sample);
+  EXPECT_EQ(0u, graph_cache.count_publishers("/chatter"));
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      EXPECT_TRUE(graph.topics.empty());
+      EXPECT_TRUE(graph.nodes.empty());
+    });
+}
+
+TEST(GraphCacheTests, name_table)
+{
+  rmw_iceoryx_cpp::NameTable names;
+  EXPECT_EQ(rmw_iceoryx_cpp::NameTable::INVALID_ID, names.find("/chatter"));
+
+  auto id = names.intern("/chatter");
+  EXPECT_EQ(id, names.intern(std::string("/chatter")));
+  EXPECT_EQ(id, names.find("/chatter"));
+  EXPECT_NE(id, names.intern("/chatter2"));
+  EXPECT_EQ("/chatter", names.name(id));
+  EXPECT_EQ(2u, names.size());
+}
+
+TEST(GraphCacheTests, ready_after_port_and_process_samples)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+  EXPECT_FALSE(graph_cache.wait_until_ready(std::chrono::milliseconds(1)));
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  graph_cache.update(port_sample);
+  EXPECT_FALSE(graph_cache.wait_until_ready(std::chrono::milliseconds(1)));
+
+  iox::roudi::ProcessIntrospectionFieldTopic process_sample;
+  iox::roudi::ProcessIntrospectionData process;
+  process.m_nodes.push_back(iox::NodeName_t(iox::cxx::TruncateToCapacity, "/ns/talker"));
+  process_sample.m_processList.push_back(process);
+
+  // the update of another thread wakes up the waiting query
+  std::thread updater([&]() {graph_cache.update(process_sample);});
+  EXPECT_TRUE(graph_cache.wait_until_ready(std::chrono::seconds(5)));
+  updater.join();
+
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      ASSERT_EQ(1u, graph.node_names.size());
+      EXPECT_EQ("/ns/talker", graph.names.name(graph.node_names.front().full_name));
+      EXPECT_EQ("talker", graph.names.name(graph.node_names.front().name));
+      EXPECT_EQ("/ns", graph.names.name(graph.node_names.front().namespace_));
+      EXPECT_EQ("/", graph.names.name(graph.node_names.front().enclave));
+    });
+}
+
+TEST(GraphCacheTests, node_names)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+
+  iox::roudi::ProcessIntrospectionFieldTopic process_sample;
+  iox::roudi::ProcessIntrospectionData process;
+  process.m_nodes.push_back(iox::NodeName_t(iox::cxx::TruncateToCapacity, "/ns/talker"));
+  process.m_nodes.push_back(iox::NodeName_t(iox::cxx::TruncateToCapacity, "/ns/listener"));
+  process_sample.m_processList.push_back(process);
+  graph_cache.update(process_sample);
+
+  // sorted by the full name
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      ASSERT_EQ(2u, graph.node_names.size());
+      EXPECT_EQ("listener", graph.names.name(graph.node_names[0].name));
+      EXPECT_EQ("talker", graph.names.name(graph.node_names[1].name));
+    });
+
+  process_sample.m_processList.back().m_nodes.erase(
+    process_sample.m_processList.back().m_nodes.begin());
+  process.m_nodes.clear();
+  process.m_nodes.push_back(iox::NodeName_t(iox::cxx::TruncateToCapacity, "/other/talker"));
+  process_sample.m_processList.push_back(process);
+  graph_cache.update(process_sample);
+
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      ASSERT_EQ(2u, graph.node_names.size());
+      EXPECT_EQ("/ns", graph.names.name(graph.node_names[0].namespace_));
+      EXPECT_EQ("listener", graph.names.name(graph.node_names[0].name));
+      EXPECT_EQ("/other", graph.names.name(graph.node_names[1].namespace_));
+      EXPECT_EQ("talker", graph.names.name(graph.node_names[1].name));
+    });
+}
+
+TEST(GraphCacheTests, deltas)
+{
+  using GraphChange = rmw_iceoryx_cpp::GraphCache::GraphChange;
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>("/ns/talker", "/chatter", "std_msgs/msg/String"));
+  port_sample.m_subscriberList.push_back(
+    make_port<iox::roudi::SubscriberPortData>("/ns/listener", "/chatter", "std_msgs/msg/String"));
+  port_sample.m_subscriberList.push_back(
+    make_port<iox::roudi::SubscriberPortData>("/ns/other", "/other", "std_msgs/msg/String"));
+  auto delta = graph_cache.update(port_sample);
+  EXPECT_EQ(1u, delta.generation);
+  EXPECT_EQ(6u, delta.changes.size());
+  EXPECT_EQ(3u, delta.affected_nodes.size());
+  // the nodes got their first endpoints
+  EXPECT_TRUE(delta.affects_all_nodes);
+
+  // an unchanged sample does not change the graph
+  EXPECT_TRUE(graph_cache.update(port_sample).empty());
+
+  // the listener of /chatter is affected by the new publisher, the other node is not
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>("/ns/talker", "/chatter", "std_msgs/msg/String"));
+  port_sample.m_publisherList.back().m_publisherPortID = 7u;
+  delta = graph_cache.update(port_sample);
+  ASSERT_EQ(1u, delta.changes.size());
+  EXPECT_EQ(GraphChange::Kind::PUBLISHER_ADDED, delta.changes.front().kind);
+  EXPECT_FALSE(delta.affects_all_nodes);
+  auto other = graph_cache.intern("/ns/other");
+  auto listener = graph_cache.intern("/ns/listener");
+  EXPECT_EQ(2u, delta.affected_nodes.size());
+  EXPECT_TRUE(
+    std::binary_search(delta.affected_nodes.begin(), delta.affected_nodes.end(), listener));
+  EXPECT_FALSE(
+    std::binary_search(delta.affected_nodes.begin(), delta.affected_nodes.end(), other));
+
+  port_sample.m_subscriberList.erase(port_sample.m_subscriberList.begin() + 1);
+  delta = graph_cache.update(port_sample);
+  ASSERT_EQ(2u, delta.changes.size());
+  EXPECT_EQ(GraphChange::Kind::SUBSCRIBER_REMOVED, delta.changes[0].kind);
+  EXPECT_EQ(GraphChange::Kind::NODE_VANISHED, delta.changes[1].kind);
+  EXPECT_EQ(other, delta.changes[1].node);
+
+  // the changes after the first update, the empty update is skipped
+  std::vector<GraphChange> changes;
+  EXPECT_TRUE(graph_cache.changes_since(1u, changes));
+  EXPECT_EQ(3u, changes.size());
+  changes.clear();
+  EXPECT_TRUE(graph_cache.changes_since(graph_cache.generation(), changes));
+  EXPECT_TRUE(changes.empty());
+
+  // nodes of the process introspection concern every node
+  iox::roudi::ProcessIntrospectionFieldTopic process_sample;
+  iox::roudi::ProcessIntrospectionData process;
+  process.m_nodes.push_back(iox::NodeName_t(iox::cxx::TruncateToCapacity, "/ns/talker"));
+  process_sample.m_processList.push_back(process);
+  delta = graph_cache.update(process_sample);
+  ASSERT_EQ(1u, delta.changes.size());
+  EXPECT_EQ(GraphChange::Kind::NODE_APPEARED, delta.changes.front().kind);
+  EXPECT_TRUE(delta.affects_all_nodes);
+  EXPECT_TRUE(graph_cache.update(process_sample).empty());
+}
+
+TEST(GraphCacheTests, delta_history)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  for (size_t i = 0; i <= rmw_iceoryx_cpp::GraphCache::DELTA_HISTORY_SIZE; ++i) {
+    port_sample.m_subscriberList.clear();
+    if (i % 2u == 0u) {
+      port_sample.m_subscriberList.push_back(
+        make_port<iox::roudi::SubscriberPortData>(
+          "/ns/listener", "/chatter", "std_msgs/msg/String"));
+    }
+    EXPECT_FALSE(graph_cache.update(port_sample).empty());
+  }
+
+  // the oldest delta was dropped, the graph has to be read in full
+  std::vector<rmw_iceoryx_cpp::GraphCache::GraphChange> changes;
+  EXPECT_FALSE(graph_cache.changes_since(0u, changes));
+  EXPECT_TRUE(graph_cache.changes_since(1u, changes));
+  EXPECT_FALSE(changes.empty());
+}
+
+TEST(GraphCacheTests, service_topics_are_hidden)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>(
+      "/client", "rq/add_two_intsRequest", "example_interfaces/srv/AddTwoInts_Request"));
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>(
+      "/server", "rr/add_two_intsReply", "example_interfaces/srv/AddTwoInts_Response"));
+  // the response topic of a client has the id of the client as event
+  port_sample.m_publisherList.back().m_caproEventMethodID =
+    iox::capro::IdString_t(iox::cxx::TruncateToCapacity, "0123456789abcdef");
+  port_sample.m_subscriberList.push_back(
+    make_port<iox::roudi::SubscriberPortData>("/listener", "/chatter", "std_msgs/msg/String"));
+  graph_cache.update(port_sample);
+
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      ASSERT_EQ(1u, graph.topics.size());
+      EXPECT_NE(nullptr, graph.find_topic("/chatter"));
+      EXPECT_EQ(1u, graph.nodes.size());
+    });
+}
+
+TEST(GraphCacheTests, node_without_endpoints)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+  // e.g. the node of `ros2 topic list`, which only queries the graph
+  auto idle = graph_cache.intern("/ns/idle");
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>("/ns/talker", "/chatter", "std_msgs/msg/String"));
+  EXPECT_TRUE(graph_cache.update(port_sample).affects(idle));
+
+  // another endpoint of a known node only concerns the nodes on the topic
+  port_sample.m_subscriberList.push_back(
+    make_port<iox::roudi::SubscriberPortData>("/ns/talker", "/chatter", "std_msgs/msg/String"));
+  auto delta = graph_cache.update(port_sample);
+  EXPECT_FALSE(delta.empty());
+  EXPECT_FALSE(delta.affects(idle));
+  EXPECT_TRUE(delta.affects(graph_cache.intern("/ns/talker")));
+}
+
+TEST(GraphCacheTests, delta_since_per_consumer)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>("/ns/talker", "/chatter", "std_msgs/msg/String"));
+  EXPECT_FALSE(graph_cache.update(port_sample).empty());
+  // the second context applies the same sample, which changes nothing anymore
+  EXPECT_TRUE(graph_cache.update(port_sample).empty());
+
+  // each context still sees the change since its own generation
+  uint64_t first_context = 0u;
+  uint64_t second_context = 0u;
+  for (auto generation : {&first_context, &second_context}) {
+    rmw_iceoryx_cpp::GraphCache::GraphDelta delta;
+    EXPECT_TRUE(graph_cache.delta_since(*generation, delta));
+    EXPECT_EQ(2u, delta.changes.size());
+    EXPECT_TRUE(delta.affects_all_nodes);
+    *generation = delta.generation;
+  }
+
+  rmw_iceoryx_cpp::GraphCache::GraphDelta delta;
+  EXPECT_TRUE(graph_cache.delta_since(first_context, delta));
+  EXPECT_TRUE(delta.empty());
+  EXPECT_EQ(graph_cache.generation(), delta.generation);
+}
+
+TEST(GraphCacheTests, services_from_request_topics)
+{
+  rmw_iceoryx_cpp::GraphCache graph_cache;
+
+  iox::roudi::PortIntrospectionFieldTopic port_sample;
+  port_sample.m_subscriberList.push_back(
+    make_port<iox::roudi::SubscriberPortData>(
+      "/server", "rq/add_two_intsRequest", "example_interfaces/srv/AddTwoInts_Request"));
+  port_sample.m_publisherList.push_back(
+    make_port<iox::roudi::PublisherPortData>(
+      "/client", "rq/ns/triggerRequest", "std_srvs/srv/Trigger_Request"));
+  graph_cache.update(port_sample);
+
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      ASSERT_EQ(2u, graph.services.size());
+      auto service = graph.services.find(graph.names.find("/add_two_ints"));
+      ASSERT_NE(graph.services.end(), service);
+      EXPECT_EQ("example_interfaces/srv/AddTwoInts", graph.names.name(service->second));
+      service = graph.services.find(graph.names.find("/ns/trigger"));
+      ASSERT_NE(graph.services.end(), service);
+      EXPECT_EQ("std_srvs/srv/Trigger", graph.names.name(service->second));
+    });
+
+  // the service is gone with its last request port
+  port_sample.m_subscriberList.clear();
+  graph_cache.update(port_sample);
+  graph_cache.read(
+    [](const rmw_iceoryx_cpp::GraphCache::Graph & graph) {
+      ASSERT_EQ(1u, graph.services.size());
+      EXPECT_EQ(graph.services.end(), graph.services.find(graph.names.find("/add_two_ints")));
+    });
+}
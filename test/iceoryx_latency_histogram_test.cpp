@@ -0,0 +1,92 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_iceoryx_cpp/iceoryx_latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <thread>
+#include <vector>
+
+using rmw_iceoryx_cpp::LatencyHistogram;
+
+TEST(LatencyHistogramTest, bucket_index)
+{
+  EXPECT_EQ(0u, LatencyHistogram::bucket_index(-10));
+  EXPECT_EQ(0u, LatencyHistogram::bucket_index(0));
+  EXPECT_EQ(1u, LatencyHistogram::bucket_index(1));
+  EXPECT_EQ(2u, LatencyHistogram::bucket_index(2));
+  EXPECT_EQ(2u, LatencyHistogram::bucket_index(3));
+  EXPECT_EQ(10u, LatencyHistogram::bucket_index(1000));
+  EXPECT_EQ(
+    LatencyHistogram::BUCKET_COUNT - 1u,
+    LatencyHistogram::bucket_index(std::numeric_limits<int64_t>::max()));
+
+  // every latency is below the upper bound of its bucket
+  for (int64_t latency : {0l, 1l, 7l, 8l, 1000l, 123456789l}) {
+    EXPECT_LT(
+      static_cast<uint64_t>(latency),
+      LatencyHistogram::bucket_upper_bound_ns(LatencyHistogram::bucket_index(latency)));
+  }
+}
+
+TEST(LatencyHistogramTest, record_and_snapshot)
+{
+  LatencyHistogram histogram;
+  histogram.record(-5);
+  histogram.record(1);
+  histogram.record(3);
+  histogram.record(1000);
+
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(4u, snapshot.count);
+  EXPECT_EQ(1004u, snapshot.sum_ns);
+  EXPECT_EQ(1000u, snapshot.max_ns);
+  EXPECT_EQ(1u, snapshot.buckets[0]);
+  EXPECT_EQ(1u, snapshot.buckets[1]);
+  EXPECT_EQ(1u, snapshot.buckets[2]);
+  EXPECT_EQ(1u, snapshot.buckets[10]);
+  EXPECT_EQ(2u, snapshot.quantile_upper_bound_ns(0.5));
+  EXPECT_EQ(1024u, snapshot.quantile_upper_bound_ns(1.0));
+
+  histogram.reset();
+  snapshot = histogram.snapshot();
+  EXPECT_EQ(0u, snapshot.count);
+  EXPECT_EQ(0u, snapshot.max_ns);
+}
+
+TEST(LatencyHistogramTest, concurrent_record)
+{
+  constexpr uint64_t RECORDS_PER_THREAD = 10000u;
+  LatencyHistogram histogram;
+
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < 4; ++i) {
+    threads.emplace_back(
+      [&histogram, i] {
+        for (uint64_t j = 0u; j < RECORDS_PER_THREAD; ++j) {
+          histogram.record(100 * (i + 1));
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(4u * RECORDS_PER_THREAD, snapshot.count);
+  EXPECT_EQ(1000u * RECORDS_PER_THREAD, snapshot.sum_ns);
+  EXPECT_EQ(400u, snapshot.max_ns);
+}
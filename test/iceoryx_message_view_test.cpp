@@ -0,0 +1,108 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_iceoryx_cpp/iceoryx_message_view.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_serialize.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/message_fixtures.hpp"
+
+#include "./test_msgs_c_fixtures.hpp"
+
+TEST(MessageViewTests, cpp_unbounded_sequences)
+{
+  auto ts = rosidl_typesupport_cpp::get_message_type_support_handle<
+    test_msgs::msg::UnboundedSequences>();
+
+  for (const auto & msg : get_messages_unbounded_sequences()) {
+    std::vector<char> payload{};
+    rmw_iceoryx_cpp::serialize(msg.get(), ts, payload);
+
+    rmw_iceoryx_cpp::MessageView view(
+      payload.data(), payload.size(), ts, rmw_iceoryx_cpp::PayloadLayout::SERIALIZED);
+    ASSERT_TRUE(view.is_valid());
+
+    auto int32_index = view.field_index("int32_values");
+    ASSERT_LT(int32_index, view.field_count());
+    auto int32_values = view.get_sequence<int32_t>(int32_index);
+    ASSERT_EQ(msg->int32_values.size(), int32_values.second);
+    for (size_t i = 0; i < int32_values.second; ++i) {
+      EXPECT_EQ(msg->int32_values[i], int32_values.first[i]);
+    }
+
+    auto float64_values = view.get_sequence<double>(view.field_index("float64_values"));
+    ASSERT_EQ(msg->float64_values.size(), float64_values.second);
+    for (size_t i = 0; i < float64_values.second; ++i) {
+      EXPECT_EQ(msg->float64_values[i], float64_values.first[i]);
+    }
+
+    // fields behind variable size fields are indexed as well
+    auto alignment_check = view.get_sequence<int32_t>(view.field_index("alignment_check"));
+    ASSERT_EQ(1u, alignment_check.second);
+    EXPECT_EQ(msg->alignment_check, *alignment_check.first);
+
+    EXPECT_THROW(view.get_sequence<int64_t>(int32_index), std::runtime_error);
+  }
+}
+
+TEST(MessageViewTests, cpp_strings)
+{
+  auto ts = rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Strings>();
+
+  for (const auto & msg : get_messages_strings()) {
+    std::vector<char> payload{};
+    rmw_iceoryx_cpp::serialize(msg.get(), ts, payload);
+
+    rmw_iceoryx_cpp::MessageView view(
+      payload.data(), payload.size(), ts, rmw_iceoryx_cpp::PayloadLayout::SERIALIZED);
+    auto string_value = view.get_string(view.field_index("string_value"));
+    EXPECT_EQ(msg->string_value, std::string(string_value.first, string_value.second));
+  }
+}
+
+TEST(MessageViewTests, cpp_nested)
+{
+  auto ts = rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Nested>();
+
+  for (const auto & msg : get_messages_nested()) {
+    std::vector<char> payload{};
+    rmw_iceoryx_cpp::serialize(msg.get(), ts, payload);
+
+    rmw_iceoryx_cpp::MessageView view(
+      payload.data(), payload.size(), ts, rmw_iceoryx_cpp::PayloadLayout::SERIALIZED);
+    auto basic_types = view.get_message(view.field_index("basic_types_value"));
+    auto int64_value = basic_types.get_sequence<int64_t>(basic_types.field_index("int64_value"));
+    EXPECT_EQ(msg->basic_types_value.int64_value, *int64_value.first);
+  }
+}
+
+TEST(MessageViewTests, c_fixed_size)
+{
+  auto ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+
+  for (const auto & msg : get_messages_basic_types_c()) {
+    // fixed size messages are sent as plain copy
+    rmw_iceoryx_cpp::MessageView view(
+      msg.get(), sizeof(*msg), ts, rmw_iceoryx_cpp::PayloadLayout::FIXED_SIZE);
+    auto uint16_value = view.get_sequence<uint16_t>(view.field_index("uint16_value"));
+    ASSERT_EQ(1u, uint16_value.second);
+    EXPECT_EQ(msg->uint16_value, *uint16_value.first);
+  }
+}
@@ -16,10 +16,19 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+#include "rmw_iceoryx_cpp/iceoryx_type_info_introspection.hpp"
+
+#include "rosidl_typesupport_cpp/service_type_support.hpp"
+
+#include "test_msgs/srv/basic_types.hpp"
+
 TEST(NameConverisonTests, get_name_n_type_from_service_description)
 {
   auto topic_and_type = rmw_iceoryx_cpp::get_name_n_type_from_service_description(
@@ -108,3 +117,104 @@ TEST(NameConverisonTests, flip_flop_reverse)
     EXPECT_EQ(tuple, flip_flop_tuple);
   }
 }
+
+TEST(NameConverisonTests, memoized_conversions_are_stable)
+{
+  // the second call is answered from the memo and has to match the first one
+  for (int i = 0; i < 2; ++i) {
+    auto topic_and_type = rmw_iceoryx_cpp::get_name_n_type_from_service_description(
+      "MemoService", "MemoInstance", "MemoEvent");
+    EXPECT_EQ("/MemoInstance/MemoService/MemoEvent", std::get<0>(topic_and_type));
+    EXPECT_EQ("memoservice_ara_msgs/msg/MemoEvent", std::get<1>(topic_and_type));
+
+    auto service_description = rmw_iceoryx_cpp::get_service_description_from_name_n_type(
+      "/MemoInstance/MemoService/MemoEvent", "memoservice_ara_msgs/msg/MemoEvent");
+    EXPECT_EQ("MemoService", std::get<0>(service_description));
+    EXPECT_EQ("MemoInstance", std::get<1>(service_description));
+    EXPECT_EQ("MemoEvent", std::get<2>(service_description));
+  }
+
+  // failed conversions are not memoized
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_THROW(
+      rmw_iceoryx_cpp::get_service_description_from_name_n_type(
+        "/_iceoryx/malformed", "iceoryx_introspection_msgs/msg/event"),
+      std::runtime_error);
+  }
+}
+
+TEST(NameConverisonTests, concurrent_conversions)
+{
+  std::vector<std::thread> threads;
+  std::atomic<int> mismatches{0};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back(
+      [&mismatches]() {
+        for (int i = 0; i < 100; ++i) {
+          auto topic = "/topic" + std::to_string(i % 10);
+          auto type = "pkg/msg/Type" + std::to_string(i % 10);
+          auto service_description =
+          rmw_iceoryx_cpp::get_service_description_from_name_n_type(topic, type);
+          auto topic_and_type = rmw_iceoryx_cpp::get_name_n_type_from_service_description(
+            std::get<0>(service_description), std::get<1>(service_description),
+            std::get<2>(service_description));
+          if (topic_and_type != std::make_tuple(topic, type)) {
+            ++mismatches;
+          }
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, mismatches.load());
+}
+
+TEST(NameConverisonTests, is_service_instance)
+{
+  EXPECT_TRUE(rmw_iceoryx_cpp::is_service_instance("rq/add_two_intsRequest"));
+  EXPECT_TRUE(rmw_iceoryx_cpp::is_service_instance("rr/ns/add_two_intsReply"));
+
+  EXPECT_FALSE(rmw_iceoryx_cpp::is_service_instance("/chatter"));
+  EXPECT_FALSE(rmw_iceoryx_cpp::is_service_instance("/rq/chatterRequest"));
+  EXPECT_FALSE(rmw_iceoryx_cpp::is_service_instance("rqRequest"));
+  EXPECT_FALSE(rmw_iceoryx_cpp::is_service_instance("rr/add_two_intsRequest"));
+}
+
+TEST(NameConverisonTests, service_descriptions)
+{
+  auto ts = rosidl_typesupport_cpp::get_service_type_support_handle<test_msgs::srv::BasicTypes>();
+  rosidl_message_type_support_t request_ts;
+  rosidl_message_type_support_t response_ts;
+  rmw_iceoryx_cpp::iceoryx_get_service_message_type_supports(ts, &request_ts, &response_ts);
+
+  auto request = rmw_iceoryx_cpp::get_iceoryx_request_service_description("/ns/srv", &request_ts);
+  EXPECT_STREQ("test_msgs/srv/BasicTypes_Request", request.getServiceIDString().c_str());
+  EXPECT_STREQ("rq/ns/srvRequest", request.getInstanceIDString().c_str());
+  EXPECT_STREQ("data", request.getEventIDString().c_str());
+  EXPECT_TRUE(rmw_iceoryx_cpp::is_service_instance(request.getInstanceIDString().c_str()));
+
+  // each client has its own response topic, told apart by the event
+  auto response = rmw_iceoryx_cpp::get_iceoryx_response_service_description(
+    "/ns/srv", &response_ts, "0123456789abcdef");
+  EXPECT_STREQ("test_msgs/srv/BasicTypes_Response", response.getServiceIDString().c_str());
+  EXPECT_STREQ("rr/ns/srvReply", response.getInstanceIDString().c_str());
+  EXPECT_STREQ("0123456789abcdef", response.getEventIDString().c_str());
+  EXPECT_TRUE(rmw_iceoryx_cpp::is_service_instance(response.getInstanceIDString().c_str()));
+}
+
+TEST(NameConverisonTests, service_name_n_type_from_request_description)
+{
+  auto name_n_type = rmw_iceoryx_cpp::get_service_name_n_type_from_request_description(
+    "example_interfaces/srv/AddTwoInts_Request", "rq/ns/add_two_intsRequest");
+  EXPECT_EQ("/ns/add_two_ints", std::get<0>(name_n_type));
+  EXPECT_EQ("example_interfaces/srv/AddTwoInts", std::get<1>(name_n_type));
+
+  // responses and topics do not describe a service
+  name_n_type = rmw_iceoryx_cpp::get_service_name_n_type_from_request_description(
+    "example_interfaces/srv/AddTwoInts_Response", "rr/add_two_intsReply");
+  EXPECT_TRUE(std::get<0>(name_n_type).empty());
+  name_n_type = rmw_iceoryx_cpp::get_service_name_n_type_from_request_description(
+    "std_msgs/msg/String", "/chatter");
+  EXPECT_TRUE(std::get<0>(name_n_type).empty());
+}
@@ -0,0 +1,252 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_iceoryx_cpp/iceoryx_publisher_statistics.hpp"
+#include "rmw_iceoryx_cpp/iceoryx_wait_spin.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include "iceoryx_posh/runtime/posh_runtime.hpp"
+#include "testutils/roudi_gtest.hpp"
+
+#include "rcutils/allocator.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/init.h"
+#include "rmw/message_sequence.h"
+#include "rmw/qos_profiles.h"
+#include "rmw/rmw.h"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/msg/strings.hpp"
+
+/// publisher and subscription are created through the rmw API against a RouDi of the test
+class PublishTests : public RouDi_GTest
+{
+protected:
+  void SetUp() override
+  {
+    iox::runtime::PoshRuntime::initRuntime("publish_test");
+    node_.implementation_identifier = rmw_get_implementation_identifier();
+    node_.name = "publish_test_node";
+    node_.namespace_ = "/";
+
+    auto publisher_options = rmw_get_default_publisher_options();
+    publisher_ = rmw_create_publisher(
+      &node_, type_supports(), "/chatter", &rmw_qos_profile_default, &publisher_options);
+    ASSERT_NE(nullptr, publisher_);
+  }
+
+  void TearDown() override
+  {
+    if (subscription_) {
+      EXPECT_EQ(RMW_RET_OK, rmw_destroy_subscription(&node_, subscription_));
+    }
+    EXPECT_EQ(RMW_RET_OK, rmw_destroy_publisher(&node_, publisher_));
+    rmw_reset_error();
+  }
+
+  static const rosidl_message_type_support_t * type_supports()
+  {
+    return rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Strings>();
+  }
+
+  /// creates the subscription and waits until RouDi connected it to the publisher
+  void subscribe()
+  {
+    auto subscription_options = rmw_get_default_subscription_options();
+    subscription_ = rmw_create_subscription(
+      &node_, type_supports(), "/chatter", &rmw_qos_profile_default, &subscription_options);
+    ASSERT_NE(nullptr, subscription_);
+    InterOpWait();
+  }
+
+  rmw_node_t node_{};
+  rmw_publisher_t * publisher_{nullptr};
+  rmw_subscription_t * subscription_{nullptr};
+};
+
+TEST_F(PublishTests, publish_without_subscriber_is_skipped)
+{
+  test_msgs::msg::Strings message;
+  message.string_value = "skipped";
+
+  uint64_t skipped = 0u;
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_skipped_publish_count(publisher_, &skipped));
+  EXPECT_EQ(0u, skipped);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_publish(publisher_, &message, nullptr));
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_skipped_publish_count(publisher_, &skipped));
+  EXPECT_EQ(1u, skipped);
+
+  // the skipped message was not kept for the late joining subscription
+  subscribe();
+  test_msgs::msg::Strings received;
+  bool taken = false;
+  EXPECT_EQ(RMW_RET_OK, rmw_take(subscription_, &received, &taken, nullptr));
+  EXPECT_FALSE(taken);
+
+  message.string_value = "received";
+  EXPECT_EQ(RMW_RET_OK, rmw_publish(publisher_, &message, nullptr));
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_skipped_publish_count(publisher_, &skipped));
+  EXPECT_EQ(1u, skipped);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_take(subscription_, &received, &taken, nullptr));
+  ASSERT_TRUE(taken);
+  EXPECT_EQ("received", received.string_value);
+}
+
+TEST_F(PublishTests, user_header_is_stamped_by_the_publisher)
+{
+  subscribe();
+  rmw_gid_t publisher_gid;
+  ASSERT_EQ(RMW_RET_OK, rmw_get_gid_for_publisher(publisher_, &publisher_gid));
+
+  test_msgs::msg::Strings message;
+  for (uint64_t sequence_number = 1u; sequence_number <= 3u; ++sequence_number) {
+    message.string_value = std::to_string(sequence_number);
+    ASSERT_EQ(RMW_RET_OK, rmw_publish(publisher_, &message, nullptr));
+  }
+
+  for (uint64_t sequence_number = 1u; sequence_number <= 3u; ++sequence_number) {
+    test_msgs::msg::Strings received;
+    bool taken = false;
+    rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+    ASSERT_EQ(
+      RMW_RET_OK, rmw_take_with_info(subscription_, &received, &taken, &message_info, nullptr));
+    ASSERT_TRUE(taken);
+    EXPECT_EQ(std::to_string(sequence_number), received.string_value);
+
+    EXPECT_EQ(sequence_number, message_info.publication_sequence_number);
+    EXPECT_GT(message_info.source_timestamp, 0);
+    EXPECT_LE(message_info.source_timestamp, message_info.received_timestamp);
+    EXPECT_EQ(
+      0, memcmp(publisher_gid.data, message_info.publisher_gid.data, RMW_GID_STORAGE_SIZE));
+  }
+}
+
+TEST_F(PublishTests, take_sequence_takes_up_to_count_messages)
+{
+  subscribe();
+  test_msgs::msg::Strings message;
+  for (int i = 1; i <= 5; ++i) {
+    message.string_value = std::to_string(i);
+    ASSERT_EQ(RMW_RET_OK, rmw_publish(publisher_, &message, nullptr));
+  }
+
+  constexpr size_t COUNT = 3u;
+  auto allocator = rcutils_get_default_allocator();
+  std::array<test_msgs::msg::Strings, COUNT> received;
+  rmw_message_sequence_t message_sequence = rmw_get_zero_initialized_message_sequence();
+  ASSERT_EQ(RMW_RET_OK, rmw_message_sequence_init(&message_sequence, COUNT, &allocator));
+  for (size_t i = 0; i < COUNT; ++i) {
+    message_sequence.data[i] = &received[i];
+  }
+  rmw_message_info_sequence_t message_info_sequence =
+    rmw_get_zero_initialized_message_info_sequence();
+  ASSERT_EQ(
+    RMW_RET_OK, rmw_message_info_sequence_init(&message_info_sequence, COUNT, &allocator));
+
+  size_t taken = 0u;
+  EXPECT_EQ(
+    RMW_RET_INVALID_ARGUMENT,
+    rmw_take_sequence(
+      subscription_, 0u, &message_sequence, &message_info_sequence, &taken, nullptr));
+  rmw_reset_error();
+
+  // a full batch, then the rest of the queue
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_take_sequence(
+      subscription_, COUNT, &message_sequence, &message_info_sequence, &taken, nullptr));
+  ASSERT_EQ(COUNT, taken);
+  EXPECT_EQ(COUNT, message_sequence.size);
+  EXPECT_EQ(COUNT, message_info_sequence.size);
+  for (size_t i = 0; i < COUNT; ++i) {
+    EXPECT_EQ(std::to_string(i + 1u), received[i].string_value);
+    EXPECT_EQ(i + 1u, message_info_sequence.data[i].publication_sequence_number);
+  }
+
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_take_sequence(
+      subscription_, COUNT, &message_sequence, &message_info_sequence, &taken, nullptr));
+  ASSERT_EQ(2u, taken);
+  EXPECT_EQ(2u, message_sequence.size);
+  EXPECT_EQ("4", received[0].string_value);
+  EXPECT_EQ("5", received[1].string_value);
+
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_take_sequence(
+      subscription_, COUNT, &message_sequence, &message_info_sequence, &taken, nullptr));
+  EXPECT_EQ(0u, taken);
+  EXPECT_EQ(0u, message_sequence.size);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_message_sequence_fini(&message_sequence));
+  EXPECT_EQ(RMW_RET_OK, rmw_message_info_sequence_fini(&message_info_sequence));
+}
+
+TEST_F(PublishTests, spin_phase_of_rmw_wait_is_counted)
+{
+  subscribe();
+  rmw_context_t context = rmw_get_zero_initialized_context();
+  context.implementation_identifier = rmw_get_implementation_identifier();
+  auto wait_set = rmw_create_wait_set(&context, 1u);
+  ASSERT_NE(nullptr, wait_set);
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::set_wait_spin_duration(wait_set, 1000u));
+
+  void * subscription_data[] = {subscription_->data};
+  rmw_subscriptions_t subscriptions{1u, subscription_data};
+  rmw_guard_conditions_t guard_conditions{0u, nullptr};
+  rmw_services_t services{0u, nullptr};
+  rmw_clients_t clients{0u, nullptr};
+  rmw_events_t events{0u, nullptr};
+  rmw_time_t timeout{0u, 10000000u};
+  auto wait = [&] {
+      subscription_data[0] = subscription_->data;
+      return rmw_wait(
+        &subscriptions, &guard_conditions, &services, &clients, &events, wait_set, &timeout);
+    };
+
+  // nothing arrives while spinning nor while blocking
+  ASSERT_EQ(RMW_RET_OK, wait());
+  EXPECT_EQ(nullptr, subscription_data[0]);
+  rmw_iceoryx_cpp::WaitSpinStatistics statistics;
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_wait_spin_statistics(wait_set, &statistics));
+  EXPECT_EQ(1u, statistics.spin_count);
+  EXPECT_EQ(0u, statistics.spin_success_count);
+
+  test_msgs::msg::Strings message;
+  ASSERT_EQ(RMW_RET_OK, rmw_publish(publisher_, &message, nullptr));
+  ASSERT_EQ(RMW_RET_OK, wait());
+  EXPECT_EQ(subscription_->data, subscription_data[0]);
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_wait_spin_statistics(wait_set, &statistics));
+  EXPECT_EQ(2u, statistics.spin_count);
+  EXPECT_EQ(1u, statistics.spin_success_count);
+
+  // a spin duration of 0 blocks right away
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::set_wait_spin_duration(wait_set, 0u));
+  ASSERT_EQ(RMW_RET_OK, wait());
+  EXPECT_EQ(subscription_->data, subscription_data[0]);
+  ASSERT_EQ(RMW_RET_OK, rmw_iceoryx_cpp::get_wait_spin_statistics(wait_set, &statistics));
+  EXPECT_EQ(2u, statistics.spin_count);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_destroy_wait_set(wait_set));
+}
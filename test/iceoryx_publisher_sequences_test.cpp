@@ -0,0 +1,91 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "types/iceoryx_subscription.hpp"
+
+namespace
+{
+std::array<uint8_t, RMW_GID_STORAGE_SIZE> gid_of(uint8_t publisher)
+{
+  std::array<uint8_t, RMW_GID_STORAGE_SIZE> gid{};
+  gid[0] = publisher;
+  gid[RMW_GID_STORAGE_SIZE - 1] = 0x2a;
+  return gid;
+}
+
+uint64_t record(IceoryxPublisherSequences & sequences, uint8_t publisher, uint64_t sequence_number)
+{
+  return record_publisher_sequence(sequences, gid_of(publisher).data(), sequence_number);
+}
+}  // namespace
+
+TEST(PublisherSequencesTests, consecutive_sequence_numbers_lose_nothing)
+{
+  IceoryxPublisherSequences sequences;
+  for (uint64_t sequence_number = 1u; sequence_number <= 5u; ++sequence_number) {
+    EXPECT_EQ(0u, record(sequences, 1u, sequence_number));
+  }
+}
+
+TEST(PublisherSequencesTests, gap_counts_the_lost_messages)
+{
+  IceoryxPublisherSequences sequences;
+  EXPECT_EQ(0u, record(sequences, 1u, 1u));
+  EXPECT_EQ(0u, record(sequences, 1u, 2u));
+  EXPECT_EQ(2u, record(sequences, 1u, 5u));
+  EXPECT_EQ(0u, record(sequences, 1u, 6u));
+}
+
+TEST(PublisherSequencesTests, first_chunk_of_a_publisher_loses_nothing)
+{
+  // a late joining subscription starts in the middle of the sequence
+  IceoryxPublisherSequences sequences;
+  EXPECT_EQ(0u, record(sequences, 1u, 42u));
+  EXPECT_EQ(1u, record(sequences, 1u, 44u));
+}
+
+TEST(PublisherSequencesTests, publishers_are_tracked_separately)
+{
+  IceoryxPublisherSequences sequences;
+  EXPECT_EQ(0u, record(sequences, 1u, 1u));
+  EXPECT_EQ(0u, record(sequences, 2u, 10u));
+  EXPECT_EQ(0u, record(sequences, 1u, 2u));
+  EXPECT_EQ(3u, record(sequences, 2u, 14u));
+  EXPECT_EQ(1u, record(sequences, 1u, 4u));
+}
+
+TEST(PublisherSequencesTests, least_recently_taken_publisher_is_evicted)
+{
+  constexpr auto MAX = static_cast<uint8_t>(IceoryxPublisherSequences::MAX_TRACKED_PUBLISHERS);
+  IceoryxPublisherSequences sequences;
+  for (uint8_t publisher = 1u; publisher <= MAX; ++publisher) {
+    EXPECT_EQ(0u, record(sequences, publisher, 1u));
+  }
+  // publisher 1 is the least recently taken from once publisher 2 took again
+  EXPECT_EQ(0u, record(sequences, 2u, 2u));
+
+  // one more publisher than the table holds replaces publisher 1
+  EXPECT_EQ(0u, record(sequences, MAX + 1, 1u));
+
+  // the gap of the evicted publisher is not counted when it is tracked again
+  EXPECT_EQ(0u, record(sequences, 1u, 5u));
+  // which evicted publisher 3, the others are still tracked
+  EXPECT_EQ(1u, record(sequences, 2u, 4u));
+  EXPECT_EQ(2u, record(sequences, MAX, 4u));
+  EXPECT_EQ(0u, record(sequences, 3u, 7u));
+}
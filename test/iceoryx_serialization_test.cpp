@@ -245,3 +245,77 @@ TEST(SerializationTests, c_flip_flop_serialize_builtins)
   auto ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Builtins);
   flip_flop_serialization<test_msgs__msg__Builtins>(std::bind(&get_messages_builtins_c), ts);
 }
+
+TEST(SerializationTests, serialized_size_upper_bound)
+{
+  auto ts = rosidl_typesupport_cpp::get_message_type_support_handle<
+    test_msgs::msg::BoundedPlainSequences>();
+  auto upper_bound = rmw_iceoryx_cpp::get_serialized_size_upper_bound(ts);
+  ASSERT_GT(upper_bound, 0u);
+  for (const auto & msg : get_messages_bounded_plain_sequences()) {
+    std::vector<char> payload{};
+    rmw_iceoryx_cpp::serialize(msg.get(), ts, payload);
+    EXPECT_LE(payload.size(), upper_bound);
+  }
+
+  // unbounded types have no upper bound
+  ts = rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Strings>();
+  EXPECT_EQ(0u, rmw_iceoryx_cpp::get_serialized_size_upper_bound(ts));
+  ts = rosidl_typesupport_cpp::get_message_type_support_handle<
+    test_msgs::msg::UnboundedSequences>();
+  EXPECT_EQ(0u, rmw_iceoryx_cpp::get_serialized_size_upper_bound(ts));
+}
+
+TEST(SerializationTests, c_deserialize_into_reserved_message)
+{
+  auto ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BoundedSequences);
+
+  test_msgs__msg__BoundedSequences deserialized_msg{};
+  test_msgs__msg__BoundedSequences__init(&deserialized_msg);
+  rmw_iceoryx_cpp::reserve_message(ts, &deserialized_msg);
+  ASSERT_EQ(3u, deserialized_msg.int32_values.capacity);
+  ASSERT_EQ(3u, deserialized_msg.string_values.capacity);
+  auto int32_data = deserialized_msg.int32_values.data;
+  auto string_data = deserialized_msg.string_values.data;
+
+  // the message is reused, the presized sequences are not reallocated
+  for (const auto & msg : get_messages_bounded_sequences_c()) {
+    std::vector<char> payload{};
+    rmw_iceoryx_cpp::serialize(msg.get(), ts, payload);
+    rmw_iceoryx_cpp::deserialize(payload.data(), ts, &deserialized_msg);
+
+    test_equality(*msg, deserialized_msg);
+    EXPECT_EQ(msg->int32_values.size, deserialized_msg.int32_values.size);
+    EXPECT_EQ(int32_data, deserialized_msg.int32_values.data);
+    EXPECT_EQ(string_data, deserialized_msg.string_values.data);
+  }
+
+  test_msgs__msg__BoundedSequences__fini(&deserialized_msg);
+}
+
+TEST(SerializationTests, reserve_plan_visits_bounded_fields)
+{
+  // types without bounded fields have nothing to presize
+  auto plan = rmw_iceoryx_cpp::get_reserve_plan(
+    rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::BasicTypes>());
+  EXPECT_EQ(plan.message_begin, plan.message_end);
+  plan = rmw_iceoryx_cpp::get_reserve_plan(
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, UnboundedSequences));
+  EXPECT_EQ(plan.message_begin, plan.message_end);
+
+  plan = rmw_iceoryx_cpp::get_reserve_plan(
+    rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::BoundedSequences>());
+  EXPECT_LT(plan.message_begin, plan.message_end);
+
+  test_msgs::msg::BoundedSequences msg{};
+  rmw_iceoryx_cpp::reserve_message(plan, &msg);
+  EXPECT_EQ(3u, msg.int32_values.capacity());
+  EXPECT_EQ(3u, msg.string_values.capacity());
+  auto int32_data = msg.int32_values.data();
+
+  // a presized message is left as it is
+  msg.int32_values.push_back(1);
+  rmw_iceoryx_cpp::reserve_message(plan, &msg);
+  EXPECT_EQ(int32_data, msg.int32_values.data());
+  EXPECT_EQ(3u, msg.int32_values.capacity());
+}
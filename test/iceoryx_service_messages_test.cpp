@@ -0,0 +1,179 @@
+// Copyright (c) 2021 by Robert Bosch GmbH. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "iceoryx_service_messages.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "iceoryx_posh/popo/untyped_publisher.hpp"
+#include "iceoryx_posh/popo/untyped_subscriber.hpp"
+#include "iceoryx_posh/runtime/posh_runtime.hpp"
+#include "testutils/roudi_gtest.hpp"
+
+#include "rmw/error_handling.h"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/message_fixtures.hpp"
+
+#include "types/iceoryx_service.hpp"
+
+TEST(ServiceMessagesTests, client_id_to_string)
+{
+  int8_t client_id[CLIENT_ID_SIZE] = {};
+  client_id[0] = 0x01;
+  client_id[1] = static_cast<int8_t>(0xab);
+  client_id[CLIENT_ID_SIZE - 1] = static_cast<int8_t>(0xff);
+
+  auto client = client_id_to_string(client_id);
+  ASSERT_EQ(2u * CLIENT_ID_SIZE, client.size());
+  EXPECT_EQ("01ab", client.substr(0, 4));
+  EXPECT_EQ("ff", client.substr(client.size() - 2));
+
+  // the id is used as iceoryx event, which has to tell the clients apart
+  client_id[0] = 0x02;
+  EXPECT_NE(client, client_id_to_string(client_id));
+}
+
+/// the tests below publish and take through a RouDi of their own
+class ServiceMessagesRouDiTests : public RouDi_GTest
+{
+protected:
+  void SetUp() override
+  {
+    iox::runtime::PoshRuntime::initRuntime("service_messages_test");
+  }
+
+  /// @brief Sends each message through a publisher and subscriber pair and takes it again
+  template<typename MessageT>
+  void round_trip(const std::vector<std::shared_ptr<MessageT>> & messages, bool is_fixed_size)
+  {
+    IceoryxServiceMessageType message_type(
+      *rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>());
+    ASSERT_EQ(is_fixed_size, message_type.is_fixed_size_);
+
+    iox::popo::UntypedSubscriber subscriber({"ServiceMessages", "RoundTrip", "data"});
+    iox::popo::UntypedPublisher publisher({"ServiceMessages", "RoundTrip", "data"});
+    InterOpWait();
+
+    int8_t client_id[CLIENT_ID_SIZE] = {};
+    client_id[0] = 0x2a;
+    int64_t sequence_number = 0;
+    for (const auto & message : messages) {
+      ++sequence_number;
+      ASSERT_EQ(
+        RMW_RET_OK,
+        send_service_message(&publisher, message_type, message.get(), client_id, sequence_number));
+
+      MessageT taken_message;
+      rmw_service_info_t service_info{};
+      bool taken{false};
+      ASSERT_EQ(
+        RMW_RET_OK,
+        take_service_message(&subscriber, message_type, &taken_message, &service_info, &taken));
+      ASSERT_TRUE(taken);
+      EXPECT_EQ(*message, taken_message);
+      EXPECT_EQ(0, std::memcmp(service_info.request_id.writer_guid, client_id, CLIENT_ID_SIZE));
+      EXPECT_EQ(sequence_number, service_info.request_id.sequence_number);
+    }
+
+    MessageT taken_message;
+    rmw_service_info_t service_info{};
+    bool taken{true};
+    EXPECT_EQ(
+      RMW_RET_OK,
+      take_service_message(&subscriber, message_type, &taken_message, &service_info, &taken));
+    EXPECT_FALSE(taken);
+  }
+};
+
+TEST_F(ServiceMessagesRouDiTests, fixed_size_round_trip)
+{
+  round_trip(get_messages_basic_types(), true);
+}
+
+TEST_F(ServiceMessagesRouDiTests, serialized_round_trip)
+{
+  round_trip(get_messages_strings(), false);
+}
+
+TEST_F(ServiceMessagesRouDiTests, chunk_without_user_header_is_dropped)
+{
+  IceoryxServiceMessageType message_type(
+    *rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::BasicTypes>());
+
+  iox::popo::UntypedSubscriber subscriber({"ServiceMessages", "NoHeader", "data"});
+  iox::popo::UntypedPublisher publisher({"ServiceMessages", "NoHeader", "data"});
+  InterOpWait();
+
+  publisher.loan(static_cast<uint32_t>(message_type.message_size_)).and_then(
+    [&](void * user_payload) {
+      std::memset(user_payload, 0, message_type.message_size_);
+      publisher.publish(user_payload);
+    });
+
+  test_msgs::msg::BasicTypes taken_message;
+  rmw_service_info_t service_info{};
+  bool taken{true};
+  EXPECT_EQ(
+    RMW_RET_ERROR,
+    take_service_message(&subscriber, message_type, &taken_message, &service_info, &taken));
+  EXPECT_FALSE(taken);
+  rmw_reset_error();
+}
+
+TEST_F(ServiceMessagesRouDiTests, response_senders_are_evicted)
+{
+  auto ts = rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Empty>();
+  IceoryxService iceoryx_service(*ts, *ts, nullptr, "/evicted", "/service_messages_test", 1u);
+
+  auto client_id = [](size_t client) {
+      std::array<int8_t, CLIENT_ID_SIZE> id{};
+      std::memcpy(id.data(), &client, sizeof(client));
+      return id;
+    };
+
+  // the least recently used client is dropped when there are too many
+  for (size_t client = 0u; client < IceoryxService::MAX_RESPONSE_SENDERS; ++client) {
+    ASSERT_NE(nullptr, get_response_sender(&iceoryx_service, client_id(client).data()));
+  }
+  ASSERT_EQ(IceoryxService::MAX_RESPONSE_SENDERS, iceoryx_service.response_senders_.size());
+  // a response to the first client makes the second one the least recently used
+  ASSERT_NE(nullptr, get_response_sender(&iceoryx_service, client_id(0u).data()));
+  ASSERT_NE(
+    nullptr,
+    get_response_sender(
+      &iceoryx_service, client_id(IceoryxService::MAX_RESPONSE_SENDERS).data()));
+  auto & response_senders = iceoryx_service.response_senders_;
+  EXPECT_EQ(IceoryxService::MAX_RESPONSE_SENDERS, response_senders.size());
+  EXPECT_EQ(1u, response_senders.count(client_id_to_string(client_id(0u).data())));
+  EXPECT_EQ(0u, response_senders.count(client_id_to_string(client_id(1u).data())));
+
+  // a client whose subscriber was connected and is gone is dropped as well
+  response_senders.begin()->second.had_subscriber_ = true;
+  std::string gone_client = response_senders.begin()->first;
+  {
+    std::lock_guard<std::mutex> lock(iceoryx_service.response_senders_mutex_);
+    drop_response_senders(&iceoryx_service);
+  }
+  EXPECT_EQ(0u, response_senders.count(gone_client));
+  EXPECT_EQ(IceoryxService::MAX_RESPONSE_SENDERS - 1u, response_senders.size());
+}